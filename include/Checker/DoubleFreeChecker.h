@@ -31,7 +31,19 @@ protected:
 	/**
 	 * Has to be implemented by the checkers.
 	 */
-	void evaluate(SrcSnkAnalysisContext *curAnalysisCxt);
+	void evaluate(const SrcSnkAnalysisContext *curAnalysisCxt);
+
+	/**
+	 * A free is compared with the ones that follow it, so the paths have to be ordered.
+	 */
+	virtual bool needsPathOrder() const {
+		return true;
+	}
+
+	/**
+	 * Allocations are the sources, deallocations and null stores the sinks.
+	 */
+	virtual void collectSourcesAndSinks(SVFGNodeSet &sources, SVFGNodeSet &sinks);
 
 	/**
 	 * Return the number of variables analyzed.
@@ -43,7 +43,14 @@ protected:
 	/**
 	 * Has to be implemented by the checkers.
 	 */
-	void evaluate(SrcSnkAnalysisContext *curAnalysisCxt);
+	void evaluate(const SrcSnkAnalysisContext *curAnalysisCxt);
+
+	/**
+	 * A lock is compared with the locks and unlocks that follow it.
+	 */
+	virtual bool needsPathOrder() const {
+		return true;
+	}
 
 	/**
 	 * Return the number of variables analyzed.
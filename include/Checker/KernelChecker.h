@@ -2,6 +2,7 @@
 #define KERNEL_CHECKER_H
 
 #include "Util/KMinerStat.h"
+#include "KernelModels/ValueFlowPass.h"
 #include <omp.h>
 
 class KernelChecker: public llvm::ModulePass {
@@ -38,10 +39,19 @@ public:
 	}
 
 	virtual void getAnalysisUsage(llvm::AnalysisUsage& au) const {
+		// The value-flow graph is shared by all checkers of the context.
+		au.addRequired<ValueFlowPass>();
 		au.setPreservesAll();
 	}
 
 protected:
+	/**
+	 * Returns the shared PAG, pointer analysis and SVFG of the context.
+	 */
+	ValueFlowPass& getValueFlow() {
+		return getAnalysis<ValueFlowPass>();
+	}
+
 	/**
 	 * Returnss the time the analysis took.
 	 */
@@ -2,12 +2,19 @@
 #define KERNEL_CHECKER_API_H
 
 #include "Util/KernelAnalysisUtil.h"
+#include <llvm/IR/ValueMap.h>
 
 class KernelCheckerAPI {
 private:
 	static KernelCheckerAPI* ckAPI;
 
 	void init();
+
+	/**
+	 * Adds the (name, type) pairs of the data file given by -kernel-api, they
+	 * override the built-in ones.
+	 */
+	void loadAPIFile(const std::string &fileName);
 public:
 	KernelCheckerAPI() { 
 		init();	
@@ -24,6 +31,7 @@ public:
     	};
 
 	typedef llvm::StringMap<CHECKER_TYPE> TDAPIMap;
+	typedef llvm::ValueMap<const llvm::Function*, CHECKER_TYPE> FuncToTypeMap;
 
 	static KernelCheckerAPI* getCheckerAPI() {
 		if(ckAPI == NULL) {
@@ -33,6 +41,15 @@ public:
 		return ckAPI;
 	}
 
+	/**
+	 * Classifies all the functions of the module, so their types are looked up
+	 * without splitting their names. 
+	 */
+	void addModule(const llvm::Module &module) {
+		for(const auto &iter : module)
+			funcToType[&iter] = getTypeByName(&iter);
+	}
+
 	bool isKAlloc(const llvm::Function* fun) const {
 		return getType(fun) == CK_KALLOC;
 	}
@@ -84,7 +101,20 @@ public:
 private:
 	TDAPIMap tdAPIMap;
 
+	// Types of the functions of the added modules.
+	FuncToTypeMap funcToType;
+
 	CHECKER_TYPE getType(const llvm::Function* F) const {
+		if(F) {
+			FuncToTypeMap::const_iterator it = funcToType.find(F);
+			if(it != funcToType.end())
+				return it->second;
+		}
+
+		return getTypeByName(F);
+	}
+
+	CHECKER_TYPE getTypeByName(const llvm::Function* F) const {
 		if(F) {
 			TDAPIMap::const_iterator it= tdAPIMap.find(F->getName().split('.').first.str());
 			if(it != tdAPIMap.end())
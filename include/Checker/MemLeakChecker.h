@@ -39,7 +39,12 @@ protected:
 	/**
 	 * Has to be implemented by the checkers.
 	 */
-	virtual void evaluate(SrcSnkAnalysisContext *curAnalysisCxt);
+	virtual void evaluate(const SrcSnkAnalysisContext *curAnalysisCxt);
+
+	/**
+	 * Allocations are the sources, deallocations and null stores the sinks.
+	 */
+	virtual void collectSourcesAndSinks(SVFGNodeSet &sources, SVFGNodeSet &sinks);
 
 	/**
 	 * Return the number of variables analyzed.
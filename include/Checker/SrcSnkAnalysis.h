@@ -8,14 +8,30 @@
 #include "Util/SVFGAnalysisUtil.h"
 #include "Util/KMinerStat.h"
 #include "Util/Bug.h"
+#include "Util/CallGraphReachability.h"
 #include "KernelModels/KernelContext.h"
 #include "KernelModels/KernelSVFGBuilder.h"
+#include "KernelModels/ValueFlowPass.h"
 #include "SVF/MemoryModel/ConsG.h"
 #include "SVF/WPA/Andersen.h"
 #include "SVF/WPA/FlowSensitive.h"
+#include <memory>
 
 typedef KCFSolver<SVFG*, KSrcSnkDPItem> CFLSrcSnkSolver;
 
+class SrcSnkAnalysis;
+
+/**
+ * Analyses that share their traversal. The first analysis of the group
+ * that runs traverses the sources of all members and evaluates them.
+ * Only members with the same sinks share a traversal, so every member
+ * gets the same paths as on its own.
+ */
+struct SrcSnkFusionGroup {
+	std::vector<SrcSnkAnalysis*> analyses;
+	bool analyzed = false;
+};
+
 /*!
  * Static Double Free Detector
  */
@@ -31,7 +47,8 @@ public:
 
 	typedef FIFOWorkList<DPItem> WorkList;
 
-	SrcSnkAnalysis(): curAnalysisCxt(nullptr), ptaCallGraph(nullptr), svfg(nullptr) {
+	SrcSnkAnalysis(): curAnalysisCxt(nullptr), ptaCallGraph(nullptr), cgReachability(nullptr), svfg(nullptr), 
+		svfgBuilder(nullptr), curModule(nullptr), curValueFlow(nullptr) {
 	}
 
 	virtual ~SrcSnkAnalysis() {
@@ -39,29 +56,28 @@ public:
 			delete pathCondAllocator;
 		pathCondAllocator = NULL;
 
-		if (svfgBuilder) {
-			delete svfg;
-			delete svfgBuilder;
-		}
+		if (cgReachability)
+			delete cgReachability;
+		cgReachability = NULL;
 
+		// The SVFG belongs to the ValueFlowPass.
 		svfg = NULL;
 		svfgBuilder = NULL;
 	}
 
-	void initialize(llvm::Module& module) {
+	void initialize(llvm::Module& module, ValueFlowPass &valueFlow) {
+		curModule = &module;
+		curValueFlow = &valueFlow;
 		kernelCxt = KernelContext::getKernelContext();
-		AndersenWaveDiff* ander = AndersenWaveDiff::createAndersenWaveDiff(module);
+		AndersenWaveDiff* ander = valueFlow.getAndersen();
 		ptaCallGraph = ander->getPTACallGraph();
+		// The API and the call graph belong to the previous context.
+		delete cgReachability;
+		cgReachability = nullptr;
+		svfgBuilder = valueFlow.getSVFGBuilder();
+		svfg = valueFlow.getSVFG();
 
-		if (svfgBuilder == NULL) {
-			svfg = new SVFGOPT(ptaCallGraph);
-			svfgBuilder = new KernelSVFGBuilder();
-			svfgBuilder->build(svfg,ander);
-		} else {
-			svfg = svfgBuilder->getSVFG();
-		}
-
-		setGraph(svfgBuilder->getSVFG());
+		setGraph(svfg);
 		consCG = ander->getConstraintGraph();
 		pag = getGraph()->getPAG();
 
@@ -77,6 +93,20 @@ public:
 
 	void analyze(const SVFGNodeSet &sources, const SVFGNodeSet &sinks);
 
+	/**
+	 * Installs the given branch conditions for all analyses and returns the previous ones.
+	 */
+	static PathCondAllocator* swapPathCondAllocator(PathCondAllocator *allocator) {
+		PathCondAllocator *old = pathCondAllocator;
+		pathCondAllocator = allocator;
+		return old;
+	}
+
+	/**
+	 * Lets the given analyses share one forward and backward traversal per source.
+	 */
+	static void fuse(const std::vector<SrcSnkAnalysis*> &analyses);
+
 	/**
 	 * Checks if the node is represents a source.
 	 */
@@ -264,9 +294,22 @@ protected:
 	StringList getAPIPath();
 
 	/**
-	 * Has to be implemented by the checkers.
+	 * Has to be implemented by the checkers. The paths of the context are already solved,
+	 * it might be shared with other checkers.
+	 */
+	virtual void evaluate(const SrcSnkAnalysisContext *curAnalysisCxt){ }
+
+	/**
+	 * Checks if the checker evaluates the flow-sensitive order of the paths.
+	 */
+	virtual bool needsPathOrder() const {
+		return false;
+	}
+
+	/**
+	 * Has to be implemented by the checkers that can be fused.
 	 */
-	virtual void evaluate(SrcSnkAnalysisContext *curAnalysisCxt){ }
+	virtual void collectSourcesAndSinks(SVFGNodeSet &sources, SVFGNodeSet &sinks) { }
 
 	/**
 	 * Checks if the sink that was found actualy does free the current memory object.
@@ -276,12 +319,30 @@ protected:
 	bool verifySrcSnk(const KSrcSnkDPItem &srcSnkItem);
 
 private:
+	/**
+	 * Traverses the sources of all fused analyses, once per set of sinks, and hands
+	 * every analysis context to the analyses the source belongs to.
+	 */
+	void analyzeFused();
+
+	/**
+	 * Runs the forward and backward traversal of a single source.
+	 */
+	void analyzeSource(const SVFGNode *source);
+
 	SVFGNodeSet sources;
 
 	SVFGNodeSet sinks;
 
+	std::shared_ptr<SrcSnkFusionGroup> fusionGroup;
+
+	llvm::Module *curModule;
+	ValueFlowPass *curValueFlow;
+
 	SrcSnkAnalysisContext *curAnalysisCxt;
 	PTACallGraph *ptaCallGraph;
+	// Built on the first API path request, calls into the API are ignored.
+	CallGraphReachability *cgReachability;
 	SVFG *svfg;
 	KernelContext *kernelCxt;
 
@@ -305,8 +366,9 @@ private:
 
 	unsigned int maxNumPaths = 100;
 
+	KernelSVFGBuilder *svfgBuilder;
+
 	static PathCondAllocator *pathCondAllocator;
-	static KernelSVFGBuilder *svfgBuilder;
 };
 
 #endif // SRCSNK_ANALYSIS_CHECKER_H_
@@ -37,7 +37,19 @@ protected:
 	/**
 	 * Has to be implemented by the checkers.
 	 */
-	virtual void evaluate(SrcSnkAnalysisContext *curAnalysisCxt);
+	virtual void evaluate(const SrcSnkAnalysisContext *curAnalysisCxt);
+
+	/**
+	 * A use is only reported if it follows a free, so the paths have to be ordered.
+	 */
+	virtual bool needsPathOrder() const {
+		return true;
+	}
+
+	/**
+	 * Allocations are the sources, deallocations, uses and null stores the sinks.
+	 */
+	virtual void collectSourcesAndSinks(SVFGNodeSet &sources, SVFGNodeSet &sinks);
 
 	/**
 	 * Return the number of variables analyzed.
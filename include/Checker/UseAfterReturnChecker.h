@@ -8,6 +8,7 @@
 #include "Util/KMinerStat.h"
 #include "Util/DirRetAnalysis.h"
 #include "Util/CallGraphAnalysis.h"
+#include "Util/KernelAnalysisUtil.h"
 #include "Util/Bug.h"
 #include "KernelModels/KernelSVFGBuilder.h"
 #include "KernelModels/KernelContext.h"
@@ -43,13 +44,13 @@ public:
 	static char ID;
 
 	UseAfterReturnChecker(unsigned int num_threads=1, char id = ID): 
-		KernelChecker("Use-After-Return", ID), num_threads(num_threads), 
-		curAnalysisCxt(nullptr), pag(nullptr), max_t(300), start_t(0) { 
+		KernelChecker("Use-After-Return", ID), num_threads(analysisUtil::getMaxThreads(num_threads)), 
+		curAnalysisCxt(nullptr), pag(nullptr), svfgBuilder(nullptr), max_t(300), start_t(0), deadline_t(0) { 
 	}
 
 	virtual ~UseAfterReturnChecker() {
-		if(pag)
-			PAG::releasePAG();
+		// The PAG and the SVFG belong to the ValueFlowPass.
+		pag = nullptr;
 
 		if(dra)
 			delete dra;
@@ -339,10 +340,11 @@ private:
 	void importSinks(StringSet &sinks);
 
 	/**
-	 * Checks if the time limit has been reached.
+	 * Checks if the time limit of the variable or the deadline of the context has been reached.
 	 */
 	bool timeout() const {
-		return omp_get_wtime()-start_t > max_t;
+		double t = omp_get_wtime();
+		return t-start_t > max_t || (deadline_t > 0 && t > deadline_t);
 	}
 
 	/**
@@ -358,8 +360,8 @@ private:
 	// Pointer Analysis.
 	AndersenWaveDiff* ander; 
 
-	// Helper class for building the SVFG. 
-    	KernelSVFGBuilder svfgBuilder;
+	// Shared builder of the SVFG, provides the kernel nodes.
+	KernelSVFGBuilder *svfgBuilder;
 
 	// Finds the variable a return value is assigned to.
 	DirRetAnalysis *dra;
@@ -374,8 +376,8 @@ private:
 	CxtToItemSet cxtToFuncRetItems;
 	NodeIdSet completedFunctions;
 
-	// The delete function names as llvm has set them.
-	StringSet sinks;
+	// IDs of the delete functions, only read by the threads.
+	IDLookup sinks;
 
 	// Set of the bugs that were imported.
 	UARBug::BugSet importedBugs;
@@ -394,6 +396,9 @@ private:
 
 	// Start of timer.
 	double start_t;
+
+	// End of the time budget of the context, 0 if there is none.
+	double deadline_t;
 };
 
 #endif // USE_AFTER_RETURN_CHECKER
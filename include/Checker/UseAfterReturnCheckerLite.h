@@ -12,6 +12,7 @@
 #include "Util/KCFSolver.h"
 #include "Util/AnalysisContext.h"
 #include "Util/CallGraphAnalysis.h"
+#include "Util/KernelAnalysisUtil.h"
 #include "Util/Bug.h"
 #include <string>
 #include <sstream>
@@ -41,13 +42,13 @@ public:
 	static char ID;
 
 	UseAfterReturnCheckerLite(unsigned int num_threads=1, char id = ID): 
-		KernelChecker("Use-After-Return", ID), num_threads(num_threads), 
-		curAnalysisCxt(nullptr), pag(nullptr), max_t(300), start_t(0) { 
+		KernelChecker("Use-After-Return", ID), num_threads(analysisUtil::getMaxThreads(num_threads)), 
+		curAnalysisCxt(nullptr), pag(nullptr), svfgBuilder(nullptr), max_t(300), start_t(0), deadline_t(0) { 
 	}
 
 	virtual ~UseAfterReturnCheckerLite() {
-		if(pag)
-			PAG::releasePAG();
+		// The PAG and the SVFG belong to the ValueFlowPass.
+		pag = nullptr;
 	}
 
 protected:
@@ -267,10 +268,11 @@ private:
 	void importSinks(StringSet &sinks);
 
 	/**
-	 * Checks if the time limit has been reached.
+	 * Checks if the time limit of the variable or the deadline of the context has been reached.
 	 */
 	bool timeout() const {
-		return omp_get_wtime()-start_t > max_t;
+		double t = omp_get_wtime();
+		return t-start_t > max_t || (deadline_t > 0 && t > deadline_t);
 	}
 
 	/**
@@ -286,8 +288,8 @@ private:
 	// Pointer Analysis.
 	AndersenWaveDiff* ander; 
 
-	// Helper class for building the SVFG. 
-    	KernelSVFGBuilder svfgBuilder;
+	// Shared builder of the SVFG, provides the kernel nodes.
+	KernelSVFGBuilder *svfgBuilder;
 
 	// Contains information that are relevant during the complete analysis.
 	UARLiteAnalysisContext *curAnalysisCxt;		
@@ -295,8 +297,8 @@ private:
 	// Contains the local and global variables (SVFGNodes).
 	SVFGNodeSet stackSVFGNodes, globalSVFGNodes;
 
-	// The delete function names as llvm has set them.
-	StringSet sinks;
+	// IDs of the delete functions, only read by the threads.
+	IDLookup sinks;
 
 	// Set of the bugs that were imported.
 	UARBug::BugSet importedBugs;
@@ -311,6 +313,9 @@ private:
 	// Start of timer.
 	double start_t;
 
+	// End of the time budget of the context, 0 if there is none.
+	double deadline_t;
+
 	// Record forward visited items.
 	SVFGNodeToDPItemsMap forwardVisitedMap;	
 	SVFGNodeToDPItemsMap backwardVisitedMap;	
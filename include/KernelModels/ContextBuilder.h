@@ -56,6 +56,12 @@ public:
 		return context;
 	}
 
+	/**
+	 * Estimates the sizes (functions and global variables) of the contexts of the
+	 * given roots without building them.
+	 */
+	std::map<std::string, uint32_t> estimateContextSizes(const StringList &cxtRootNames);
+
 protected:
 
 	/**
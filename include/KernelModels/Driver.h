@@ -20,8 +20,8 @@ public:
 
 	Driver(std::string name, 
 		const StringSet &cxtRoot,
-		const StringSet &functions, 
-		const StringSet &globalvars,
+		const IDSet &functions, 
+		const IDSet &globalvars,
 		uint32_t maxCGDepth): 
 		KernelContextObj(CONTEXT_TYPE::DRIVER, name) { 
 			setContextRoot(cxtRoot);	
@@ -51,8 +51,8 @@ public:
 		llvm::outs() << "==================\n";
 		llvm::outs() << "Driver " << name << ":\n";
 		llvm::outs() << "Num API functions= " << cxtRoot.size() << "\n";
-		llvm::outs() << "Num functions= " << functions.size() << "\n";
-		llvm::outs() << "Num globalvars= " << globalvars.size() << "\n";
+		llvm::outs() << "Num functions= " << functions.count() << "\n";
+		llvm::outs() << "Num globalvars= " << globalvars.count() << "\n";
 		llvm::outs() << "MaxCGDepth= " << maxCGDepth << "\n";
 		llvm::outs() << "------------------\n";
 	}
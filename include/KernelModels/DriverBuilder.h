@@ -28,6 +28,12 @@ private:
 	 * Find the functions inside the driver file. (API)
 	 */
 	void defineDriverAPI(Driver *driver);
+
+	/**
+	 * Get the api functions that are not called (transitively) by another api function.
+	 * All api functions are propagated through the call graph at once.
+	 */
+	StringSet findAPIRoots(const StringSet &api);
 };
 
 
@@ -15,6 +15,20 @@ class Initcall;
 typedef std::map<std::string, Initcall> InitcallMap;
 typedef std::set<std::string> InitcallNameSet;
 typedef std::list<Initcall> InitcallList;
+typedef std::map<std::string, IDSet> StrToIDSet;
+
+/**
+ * The values an initcall uses to define one of its non defined global variables.
+ */
+struct NonDefVarUse {
+	std::string initcall;
+	IDSet functions;
+	IDSet globalvars;
+};
+
+typedef std::vector<NonDefVarUse> NonDefVarUseList;
+// Maps the ID of a non defined global variable to the initcalls using it.
+typedef std::map<uint32_t, NonDefVarUseList> NonDefVarIndex;
 
 /***
  * Contains the used functions, global variables and non
@@ -29,9 +43,9 @@ public:
 
 	Initcall(std::string name, 
 		uint32_t level,
-		const StringSet &functions, 
-		const StringSet &globalvars, 
-		const StringSet &nondefvars,
+		const IDSet &functions, 
+		const IDSet &globalvars, 
+		const IDSet &nondefvars,
 		uint32_t maxCGDepth): 
 		KernelContextObj(CONTEXT_TYPE::INITCALL, name),  
 		level(level), 
@@ -60,23 +74,37 @@ public:
 	}
 
 	/**
-	 * Get the used non defined global variables.
+	 * Get the names of the used non defined global variables.
 	 */
-	StringSet& getNonDefVars() {
-		return nondefvars;
+	StringSet getNonDefVars() const {
+		return ValueIDMap::getValueIDMap()->getNames(nondefvars);
 	}
 
 	/**
-	 * Get the used non defined global variables.
+	 * Get the IDs of the used non defined global variables.
 	 */
-	const StringSet& getNonDefVars() const {
+	const IDSet& getNonDefVarIDs() const {
 		return nondefvars;
 	}
 
+	/**
+	 * Get the number of used non defined global variables.
+	 */
+	uint32_t getNumNonDefVars() const {
+		return nondefvars.count();
+	}
+
 	/**
 	 * Set the used non defined global variables.
 	 */
 	void setNonDefVars(const StringSet &set) {
+		nondefvars = ValueIDMap::getValueIDMap()->getIDs(set);
+	}
+
+	/**
+	 * Set the used non defined global variables.
+	 */
+	void setNonDefVars(const IDSet &set) {
 		nondefvars = set;
 	}
 
@@ -84,22 +112,24 @@ public:
 	 * Intersects the given non defined global variables 
 	 * with the stored one.
 	 */
-	void intersectNonDefVars(const StringSet &set) {
-		StringSet interSet;
-		set_intersection(nondefvars.cbegin(), nondefvars.cend(), 
-				 set.begin(), set.end(), 
-				 std::inserter(interSet, interSet.begin()));
+	void intersectNonDefVars(const IDSet &set) {
+		nondefvars &= set;
+	}
 
-		nondefvars = interSet;
+	/**
+	 * Removes the given non defined global variables.
+	 */
+	void removeNonDefVars(const IDSet &set) {
+		nondefvars.intersectWithComplement(set);
 	}
 
 	/**
 	 * Initersects the whole initcall with the given one.
 	 */
 	virtual void intersect(const Initcall &initcall) {
-		intersectFunctions(initcall.getFunctions());
-		intersectGlobalVars(initcall.getGlobalVars());
-		intersectNonDefVars(initcall.getNonDefVars());
+		intersectFunctions(initcall.getFunctionIDs());
+		intersectGlobalVars(initcall.getGlobalVarIDs());
+		intersectNonDefVars(initcall.getNonDefVarIDs());
 		maxCGDepth = maxCGDepth < initcall.getMaxCGDepth() ? maxCGDepth : initcall.getMaxCGDepth();
 	}
 
@@ -139,11 +169,11 @@ public:
 		outs() << "==================\n";
 		outs() << "Initcall " << name << ":\n";
 		outs() << "Level " << level << ":\n";
-		outs() << "Num functions= " << functions.size() << "\n";
-		debugUtil::printStringSet(functions, "Functions");
-		outs() << "Num globalvars= " << globalvars.size() << "\n";
-		outs() << "Num nondefvars= " << nondefvars.size() << "\n";
-		debugUtil::printStringSet(nondefvars, "NonDefVars");
+		outs() << "Num functions= " << functions.count() << "\n";
+		debugUtil::printStringSet(getFunctions(), "Functions");
+		outs() << "Num globalvars= " << globalvars.count() << "\n";
+		outs() << "Num nondefvars= " << nondefvars.count() << "\n";
+		debugUtil::printStringSet(getNonDefVars(), "NonDefVars");
 		outs() << "MaxCGDepth= " << maxCGDepth << "\n";
 		outs() << "------------------\n";
 	}
@@ -158,7 +188,7 @@ protected:
 
 	// Relevant non defined global variables of the initcall.
 	// (These global vairbales are also in the other set.)
-	StringSet nondefvars;
+	IDSet nondefvars;
 };
 
 #endif // INITCALL_H
@@ -15,6 +15,7 @@
 
 typedef std::set<std::string> StringSet;
 typedef std::map<std::string, StringSet> StrToStrSet;
+typedef std::map<uint32_t, IDSet> IDToIDSet;
 
 #define toDigit(c) (c-'0')
 
@@ -26,18 +27,18 @@ struct InitcallGroup {
 	uint32_t ID;
 	uint32_t level;
 	StringSet initcalls;
-	StringSet functions;
-	StringSet globalvars;
-	StringSet nondefvars;
+	IDSet functions;
+	IDSet globalvars;
+	IDSet nondefvars;
 
 	void dump() {
 		outs() << "==================\n";
 		outs() << "InitcallGroup" << ID << " (" << level << "):\n";
 		outs() << "------------------\n";
 		outs() << "Num initcalls= " << initcalls.size() << "\n";
-		outs() << "Num functions= " << functions.size() << "\n";
-		outs() << "Num globalvars= " << globalvars.size() << "\n";
-		outs() << "Num nondefvars= " << nondefvars.size() << "\n";
+		outs() << "Num functions= " << functions.count() << "\n";
+		outs() << "Num globalvars= " << globalvars.count() << "\n";
+		outs() << "Num nondefvars= " << nondefvars.count() << "\n";
 		outs() << "------------------\n";
 		debugUtil::printStringSet(initcalls, "Initcalls");
 	}
@@ -113,18 +114,17 @@ private:
 	/**
 	 * Get the next group that matches the given leven and the function limit of the group.
 	 */
-	InitcallGroup& getNextFreeInitcallGroup(uint32_t level, const StringSet &newFunctions) {
+	InitcallGroup& getNextFreeInitcallGroup(uint32_t level, const IDSet &newFunctions) {
 		uint32_t newID = initcallGroups.size();
+		uint32_t numNewFunctions = newFunctions.count();
 
 		for(auto &iter : initcallGroups) {
 			InitcallGroup &group = iter;
-			StringSet interSet;
-
-			set_intersection(group.functions.cbegin(), group.functions.cend(), newFunctions.begin(), 
-					newFunctions.end(), std::inserter(interSet, interSet.begin()));
 
 			if(group.level == level) {
-				if((group.functions.size()+(newFunctions.size()-interSet.size())) 
+				IDSet interSet = group.functions & newFunctions;
+
+				if((group.functions.count()+(numNewFunctions-interSet.count())) 
 				   <= InitcallGroup::funcLimit)
 					return group;
 			}
@@ -145,25 +145,44 @@ private:
 	 */
 	void handleInitcallGroup(InitcallGroup &group);
 
+	/**
+	 * Handles the groups of one level in worker processes, one process per group. 
+	 * The pre-analysis already started the OpenMP threads of this process, so the
+	 * workers run single-threaded. Only as many groups run concurrently as fit into
+	 * the memory budget. A group whose worker failed gets one more worker, then it is skipped.
+	 */
+	void handleInitcallLevel(const std::vector<InitcallGroup*> &groups);
+
+	/**
+	 * Get the outcome of a handled group (initcalls, functions of its non defined
+	 * variables and the call graph depth) as a message for the parent process.
+	 */
+	std::string getGroupResult(const InitcallGroup &group) const;
+
+	/**
+	 * Merges the outcome of a group handled by a worker. Returns the ID of the group.
+	 */
+	uint32_t mergeGroupResult(const std::string &msg);
+
 	/**
 	 * Merges the relevant function of a non defined global variable, with the one that
 	 * were already found by previous groups.
 	 */
-	void mergeNonDefVarFunctions(const StrToStrSet &groupNonDefVarFuncs, 
-				     const StrToStrSet &groupNonDefVarGVs) {
-		for(auto iter : groupNonDefVarFuncs) {
-			std::string nondefvar = iter.first;
-			const StringSet &functions = iter.second;
-			nonDefVarFuncs[nondefvar].insert(functions.begin(), functions.end());
-		}
+	void mergeNonDefVarFunctions(const IDToIDSet &groupNonDefVarFuncs, 
+				     const IDToIDSet &groupNonDefVarGVs) {
+		for(const auto &iter : groupNonDefVarFuncs)
+			nonDefVarFuncs[iter.first] |= iter.second;
 
-		for(auto iter : groupNonDefVarGVs) {
-			std::string nondefvar = iter.first;
-			const StringSet &globalvars = iter.second;
-			nonDefVarGVs[nondefvar].insert(globalvars.begin(), globalvars.end());
-		}
+		for(const auto &iter : groupNonDefVarGVs)
+			nonDefVarGVs[iter.first] |= iter.second;
 	}
 
+	/**
+	 * Maps every non defined global variable to the initcalls using it, together with the 
+	 * functions and global variables of the initcall that belong to the variable.
+	 */
+	void buildNonDefVarIndex();
+
 	/**
 	 * Replaces the existing initcalls with the new one.
 	 */
@@ -216,15 +235,28 @@ private:
 	/**
 	 * Imports all initcalls with the information that where 
 	 * determined during the pre-analysis in a previuos analysis.
+	 * Results of another kernel or version are not imported.
 	 */
 	bool importPreAnalysisResults();
 
+	/**
+	 * Imports the results of the former text format, it doesn't know its kernel.
+	 */
+	bool importTextPreAnalysisResults(std::ifstream &in);
+
 	/**
 	 * Exports the initcalls with the information determined in
-	 * the pre-analysis.
+	 * the pre-analysis. The binary file consists of a header (module hash,
+	 * identity of the bitcode file, version), a string table and the sets
+	 * as IDs of the kernel numbering.
 	 */
 	bool exportPreAnalysisResults();
 
+	/**
+	 * Hashes the contents of the bitcode file of the module. Returns false if it can't be read.
+	 */
+	bool getModuleHash(uint8_t hash[16]) const;
+
 	/** 
 	 * Finds all relevant functions and globalvariables of a initcall.
 	 * For reasons of optimization, a max depth is given. The callgraph
@@ -245,6 +277,7 @@ private:
 		this->pta = new PTACallGraph(&module);
 
 		preAnalysis();
+		buildNonDefVarIndex();
 	}
 
 	~InitcallFactory() { 
@@ -264,12 +297,30 @@ public:
 		return initcallFactory;
 	}
 
+	/**
+	 * Set the number of processes and the memory (kB) the initcall groups of a level
+	 * may use together. (no budget means a fixed number of workers)
+	 */
+	static void setWorkers(uint32_t numWorkers, uint64_t memBudget) {
+		InitcallFactory::numWorkers = numWorkers;
+		InitcallFactory::memBudget = memBudget;
+	}
+
 	static void releaseInitcallFactory() {
 		if(initcallFactory)
 			delete initcallFactory;
 		initcallFactory = nullptr;
 	}
 
+	/**
+	 * Replaces the factory, the previous one is returned.
+	 */
+	static InitcallFactory* swapInitcallFactory(InitcallFactory *factory) {
+		InitcallFactory *old = initcallFactory;
+		initcallFactory = factory;
+		return old;
+	}
+
 	/**
 	 * Get the created initcalls.
 	 */
@@ -302,28 +353,24 @@ public:
 	 * Get the number of functions of all the initcalls.
 	 */
 	uint32_t getNumRelevantFunctions() const {
-		StringSet tmpSet;
+		IDSet tmpSet;
 
-		for(auto initcall : initcalls) {
-			const StringSet &functions = initcall.second.getFunctions();
-			tmpSet.insert(functions.begin(), functions.end());
-		}
+		for(const auto &initcall : initcalls)
+			tmpSet |= initcall.second.getFunctionIDs();
 
-		return tmpSet.size();
+		return tmpSet.count();
 	}
 
 	/**
 	 * Get the number of global variable of all the initcalls.
 	 */
 	uint32_t getNumRelevantGlobalVars() const {
-		StringSet tmpSet;
+		IDSet tmpSet;
 
-		for(auto initcall : initcalls) {
-			const StringSet &globalvars = initcall.second.getGlobalVars();
-			tmpSet.insert(globalvars.begin(), globalvars.end());
-		}
+		for(const auto &initcall : initcalls)
+			tmpSet |= initcall.second.getGlobalVarIDs();
 
-		return tmpSet.size();
+		return tmpSet.count();
 	}
 
 	/**
@@ -336,25 +383,25 @@ public:
 	/**
 	 * Get the functions that are relevant for the given initcall.
 	 */
-	const StringSet& getInitcallFunctions(std::string initcallName) const {
+	const IDSet& getInitcallFunctions(std::string initcallName) const {
 		const Initcall &initcall = initcalls.at(initcallName);
-		return initcall.getFunctions();
+		return initcall.getFunctionIDs();
 	}
 		
 	/**
 	 * Get the global variables that are relevant for the given initcall.
 	 */
-	const StringSet& getInitcallGlobalVars(std::string initcallName) const {
+	const IDSet& getInitcallGlobalVars(std::string initcallName) const {
 		const Initcall &initcall = initcalls.at(initcallName);
-		return initcall.getGlobalVars();
+		return initcall.getGlobalVarIDs();
 	}
 
 	/**
 	 * Get the non defined variables that are relevant for the given initcall.
 	 */
-	const StringSet& getInitcallNonDefVars(std::string initcallName) const {
+	const IDSet& getInitcallNonDefVars(std::string initcallName) const {
 		const Initcall &initcall = initcalls.at(initcallName);
-		return initcall.getNonDefVars();
+		return initcall.getNonDefVarIDs();
 	}
 
 	/**
@@ -398,18 +445,25 @@ public:
 	}
 
 	/**
-	 * Get the functions of the non defined global variables.
+	 * Get the functions of the non defined global variables (by their IDs).
 	 */
-	const StrToStrSet& getNonDefVarFuncs() const {
+	const IDToIDSet& getNonDefVarFuncs() const {
 		return nonDefVarFuncs;
 	}
 
 	/**
-	 * Get the globalvars of the non defined global variables.
+	 * Get the globalvars of the non defined global variables (by their IDs).
 	 */
-	const StrToStrSet& getNonDefVarGVs() const {
+	const IDToIDSet& getNonDefVarGVs() const {
 		return nonDefVarGVs;
 	}	
+
+	/**
+	 * Get the initcalls of the non defined global variables.
+	 */
+	const NonDefVarIndex& getNonDefVarIndex() const {
+		return nonDefVarIndex;
+	}
 	
 private:
 	// The gerneral callgraph. (not optimized)
@@ -422,10 +476,13 @@ private:
 	InitcallGroupList initcallGroups;
 
 	// All corresponging/relevant functions of a potentially non defined globalvar.
-	StrToStrSet nonDefVarFuncs;
+	IDToIDSet nonDefVarFuncs;
 
 	// All corresponging/relevant globalvars of a potentially non defined globalvar.
-	StrToStrSet nonDefVarGVs;
+	IDToIDSet nonDefVarGVs;
+
+	// The initcalls of a non defined globalvar and their values belonging to it.
+	NonDefVarIndex nonDefVarIndex;
 
 	// The maximal depth the initcalls were analyzed.
 	static uint32_t maxCGDepth;
@@ -436,6 +493,10 @@ private:
 	// The maximal number of global variables used by all initcalls. 
 	static uint32_t maxNumInitcallGlobalVars;
 
+	// Processes and memory (kB) for the initcall groups of a level.
+	static uint32_t numWorkers;
+	static uint64_t memBudget;
+
 	// A funtion which name contains this string as a substring is
 	// interpreted as an initcall.
 	const std::string initcallSubName = "__initcall_";
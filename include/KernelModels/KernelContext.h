@@ -7,6 +7,7 @@
 #include "SVF/Util/BasicTypes.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Function.h"
+#include <omp.h>
 
 typedef std::set<std::string> StringSet;
 typedef std::map<std::string, StringSet> StrToStrSet;
@@ -20,7 +21,7 @@ typedef std::map<int, StringSet> IntToStrSet;
 class KernelContext {
 	static KernelContext *cxtContainer;
 
-	KernelContext() : api(nullptr) { }
+	KernelContext() : api(nullptr), timeBudget(0), budgetStart_t(0) { }
 
 	~KernelContext() { }
 public:
@@ -40,6 +41,15 @@ public:
 		cxtContainer = nullptr;
 	}
 
+	/**
+	 * Replaces the context, the previous one is returned.
+	 */
+	static KernelContext* swapKernelContext(KernelContext *kernelCxt) {
+		KernelContext *old = cxtContainer;
+		cxtContainer = kernelCxt;
+		return old;
+	}
+
 	/**
 	 * Set the original values of the kernel, before
 	 * the module (kernel) is minimized.
@@ -53,7 +63,7 @@ public:
 	/**
 	 * Checks if the functions is either a system call or a driver.
 	 */
-	bool isAPIFunction(std::string name) {
+	bool isAPIFunction(const std::string &name) {
 		assert(api&& "The object of the kernel context has not been defined");
 		if(api->inContextRoot(name))
 			return true;
@@ -64,13 +74,36 @@ public:
 		return false;
 	}
 
+	/**
+	 * Checks if the functions is either a system call or a driver.
+	 */
+	bool isAPIFunction(const llvm::Function *F) const {
+		assert(api&& "The object of the kernel context has not been defined");
+		return F && F->hasName() && apiRoots.count(ValueIDMap::getValueIDMap()->getID(F));
+	}
+
 	/**
 	 * Checks if the functions is either in the system call or the driver context.
 	 */
-	bool inAPIContext(std::string name) {
-		return api->hasFunction(name);	
+	bool inAPIContext(const std::string &name) const {
+		uint32_t id;
+		return ValueIDMap::getValueIDMap()->lookupID(name, id) && apiFunctions.count(id);
 	}
 
+	/**
+	 * Checks if the functions is either in the system call or the driver context.
+	 */
+	bool inAPIContext(const llvm::Function *F) const {
+		return F && F->hasName() && apiFunctions.count(ValueIDMap::getValueIDMap()->getID(F));
+	}
+
+	/**
+	 * Copies the functions of the API into the lookup of inAPIContext, which
+	 * the analyses query concurrently. Has to be called after the functions of
+	 * the API changed.
+	 */
+	void updateAPILookup();
+
 	StringSet getAPIFunctions() {
 		StringSet &apiFunc = api->getContextRoot();
 
@@ -107,28 +140,18 @@ public:
 	IntToStrSet getInitcallLevelMap();
 
 	/**
-	 * Set the functions that are used by global variables, that
-	 * are potentialy not defined. 
+	 * Set the initcalls of the non defined global variables.
 	 */
-	void setNonDefVarFuncs(const StrToStrSet &nonDefVarFuncs);
-
-	/**
-	 * Get the functions that are used by global variables, that
-	 * are potentialy not defined. 
-	 */
-	StrToStrSet& getNonDefVarFuncs();
-
-	/**
-	 * Set the global vars that are used by global variables, that
-	 * are potentialy not defined. 
-	 */
-	void setNonDefVarGVs(const StrToStrSet &nonDefVarGVs);
+	void setNonDefVarIndex(const NonDefVarIndex &nonDefVarIndex) {
+		this->nonDefVarIndex = nonDefVarIndex;
+	}
 
 	/**
-	 * Get the global vars that are used by global variables, that
-	 * are potentialy not defined. 
+	 * Get the initcalls of the non defined global variables.
 	 */
-	const StrToStrSet& getNonDefVarGVs();
+	const NonDefVarIndex& getNonDefVarIndex() const {
+		return nonDefVarIndex;
+	}
 
 	/**
 	 * Checks if a function is an initcall.
@@ -171,16 +194,27 @@ public:
 	uint32_t getInitcallsMaxCGDepth() const;
 
 	/**
-	 * Get the functions used by a non defined global variable and which is also used
-	 * by the given initcall.
+	 * Set the time (sec) the checkers may spend on the current context, 0 means no budget.
+	 */
+	void setTimeBudget(double budget) {
+		timeBudget = budget;
+		budgetStart_t = omp_get_wtime();
+	}
+
+	/**
+	 * Get the time (sec) the checkers may spend on the current context.
 	 */
-	StringSet getNonDefVarFunctions(const Initcall &initcall, const StringSet &nonDefVars) const;
+	double getTimeBudget() const {
+		return timeBudget;
+	}
 
 	/**
-	 * Get the globalvars used by a non defined global variable and which is also used
-	 * by the given initcall.
+	 * Get the time (sec) that is left of the budget, the partitioner and
+	 * the pointer analysis already used a part of it.
 	 */
-	StringSet getNonDefVarGlobalVars(const Initcall &initcall, const StringSet &nonDefVars) const;
+	double getRemainingTime() const {
+		return std::max(0.0, timeBudget - (omp_get_wtime() - budgetStart_t));
+	}
 
 	/**
 	 * Get the original number of functions inside the kernel.
@@ -201,22 +235,32 @@ private:
 	// Can be for instance a system call or driver.
 	KernelContextObj *api;
 
+	// IDs of the context root of the api, including the alias of a system call.
+	IDLookup apiRoots;
+
+	// IDs of the functions of the api.
+	IDLookup apiFunctions;
+
 	// Map of all initcalls that might by relevant for the analysis.
 	InitcallMap initcalls;
 
+	// Time budget of the current context.
+	double timeBudget;
+
+	// Time when the budget was set.
+	double budgetStart_t;
+
 	// The original values of the kernel. (before the minimisation).
 	static uint32_t kernelOrigNumFunctions;
 	static uint32_t kernelOrigNumGlobalVars;
 	static uint32_t kernelOrigNumNonDefVars;
 	
-	// Set the functions that are used by global variables, that 
-	// are potentialy not defined. The global variable has
-	// to be used in the systemcall and a function has to by used
-	// by at least one initcall. The global variable has also to 
-	// be a structure(-pointer), array or a structure containing a
-	// other structure pointer.
-	StrToStrSet nonDefVarFuncs;
-	StrToStrSet nonDefVarGVs;
+	// The initcalls using a non defined global variable and the functions and 
+	// global variables they use of it. The global variable has to be used in 
+	// the systemcall and a function has to by used by at least one initcall. 
+	// The global variable has also to be a structure(-pointer), array or a 
+	// structure containing a other structure pointer.
+	NonDefVarIndex nonDefVarIndex;
 };
 
 #endif // KERNEL_CONTEXT_H
@@ -17,8 +17,13 @@
  */
 class KernelContextFactory {
 public:
-	KernelContextFactory(llvm::Module &module): 
-		kernelCxt(nullptr), apiBuilder(nullptr), initcallFactory(nullptr), module(module) {
+	/**
+	 * A resident factory doesn't need a system call or driver to be selected,
+	 * the contexts are selected later by selectAPI.
+	 */
+	KernelContextFactory(llvm::Module &module, bool resident = false): 
+		kernelCxt(nullptr), apiBuilder(nullptr), initcallFactory(nullptr), 
+		apiType(KernelContextObj::UNKNOWN), resident(resident), module(module) {
 		initialize();
 	}
 
@@ -41,6 +46,40 @@ public:
 	 */
 	bool updateContext();
 
+	/**
+	 * Checks if further contexts will follow the current one.
+	 */
+	bool hasNextContext() const {
+		return !rawAPIList.empty();
+	}
+
+	/**
+	 * Get the roots of the contexts that haven't been analyzed yet.
+	 */
+	const StringList& getContextRoots() const {
+		return rawAPIList;
+	}
+
+	/**
+	 * Replace the roots of the contexts that will be analyzed next.
+	 */
+	void setContextRoots(const StringList &cxtRoots) {
+		rawAPIList = cxtRoots;
+	}
+
+	/**
+	 * Selects the context that will be analyzed next, the type is either a
+	 * system call or a driver.
+	 */
+	void selectAPI(const std::string &cxtRoot, KernelContextObj::CONTEXT_TYPE type);
+
+	/**
+	 * Estimates the sizes (functions and global variables) of the contexts of the roots.
+	 */
+	std::map<std::string, uint32_t> estimateContextSizes(const StringList &cxtRoots) {
+		return apiBuilder != nullptr ? apiBuilder->estimateContextSizes(cxtRoots) : std::map<std::string, uint32_t>();
+	}
+
 private:
 	
 	/**
@@ -61,10 +100,18 @@ private:
 	 */
 	std::string getNextCxtRoot();
 
+	/**
+	 * Collects the system calls of a sweep (all known ones or the ones of
+	 * the given list) that are defined in the module.
+	 */
+	void collectSyscalls();
+
 	StringList rawAPIList;
 	ContextBuilder *apiBuilder; 
 	InitcallFactory *initcallFactory;
 	KernelContext *kernelCxt;
+	KernelContextObj::CONTEXT_TYPE apiType;
+	bool resident;
 	ContextStat cxtStat;
 	llvm::Module &module;
 };
@@ -2,6 +2,7 @@
 #define KERNEL_CONTEXT_OBJ_H
 
 #include "Util/BasicTypes.h"
+#include "Util/ValueIDMap.h"
 #include <algorithm> 
 
 class KernelContextObj;
@@ -29,8 +30,8 @@ public:
 	KernelContextObj(CONTEXT_TYPE type,
 		std::string name, 
 		const StringSet &cxtRoot,
-		const StringSet &functions, 
-		const StringSet &globalvars,
+		const IDSet &functions, 
+		const IDSet &globalvars,
 		uint32_t maxCGDepth):
 		type(type),
 		name(name), 
@@ -91,38 +92,69 @@ public:
 
 
 	/**
-	 * Get the functions.
+	 * Get the names of the functions.
 	 */
-	StringSet& getFunctions() {
-		return functions;
+	StringSet getFunctions() const {
+		return ValueIDMap::getValueIDMap()->getNames(functions);
 	}
 
 	/**
-	 * Get the functions.
+	 * Get the IDs of the functions.
 	 */
-	const StringSet& getFunctions() const {
+	const IDSet& getFunctionIDs() const {
 		return functions;
 	}
 
+	/**
+	 * Get the number of functions.
+	 */
+	uint32_t getNumFunctions() const {
+		return functions.count();
+	}
+
 	/**
 	 * Set the functions.
 	 */
 	void setFunctions(const StringSet &set) {
+		functions = ValueIDMap::getValueIDMap()->getIDs(set);
+	}
+
+	/**
+	 * Set the functions.
+	 */
+	void setFunctions(const IDSet &set) {
 		functions = set;
 	}
 
 	/**
 	 * Checks if the system call has a certain functions.
+	 * (Not thread-safe, the lookup moves the iterator of the set)
 	 */
-	bool hasFunction(std::string name) const {
-		return functions.find(name) != functions.end();
+	bool hasFunction(std::string name) {
+		uint32_t id;
+		return ValueIDMap::getValueIDMap()->lookupID(name, id) && hasFunction(id);
+	}
+
+	/**
+	 * Checks if the system call has a certain functions.
+	 * (Not thread-safe, the lookup moves the iterator of the set)
+	 */
+	bool hasFunction(uint32_t id) {
+		return functions.test(id);
 	}
 
 	/**
 	 * Add relevant functions.
 	 */
 	void addFunctions(const StringSet &set) {
-		functions.insert(set.begin(), set.end());
+		functions |= ValueIDMap::getValueIDMap()->getIDs(set);
+	}
+
+	/**
+	 * Add relevant functions.
+	 */
+	void addFunctions(const IDSet &set) {
+		functions |= set;
 	}
 
 	/**
@@ -130,32 +162,49 @@ public:
 	 * stored one.
 	 */
 	void intersectFunctions(const StringSet &set) {
-		StringSet interSet;
-		set_intersection(functions.cbegin(), functions.cend(), 
-				 set.begin(), set.end(), 
-				 std::inserter(interSet, interSet.begin()));
+		functions &= ValueIDMap::getValueIDMap()->getIDs(set);
+	}
 
-		functions = interSet;
+	/**
+	 * Intersects the given functions with the 
+	 * stored one.
+	 */
+	void intersectFunctions(const IDSet &set) {
+		functions &= set;
 	}
 
 	/**
-	 * Get the used global variables.
+	 * Get the names of the used global variables.
 	 */
-	StringSet& getGlobalVars() {
-		return globalvars;
+	StringSet getGlobalVars() const {
+		return ValueIDMap::getValueIDMap()->getNames(globalvars);
 	}
 
 	/**
-	 * Get the used global variables.
+	 * Get the IDs of the used global variables.
 	 */
-	const StringSet& getGlobalVars() const {
+	const IDSet& getGlobalVarIDs() const {
 		return globalvars;
 	}
 
+	/**
+	 * Get the number of used global variables.
+	 */
+	uint32_t getNumGlobalVars() const {
+		return globalvars.count();
+	}
+
 	/**
 	 * Set the used global variables.
 	 */
 	void setGlobalVars(const StringSet &set) {
+		globalvars = ValueIDMap::getValueIDMap()->getIDs(set);
+	}
+
+	/**
+	 * Set the used global variables.
+	 */
+	void setGlobalVars(const IDSet &set) {
 		globalvars = set;
 	}
 
@@ -163,14 +212,23 @@ public:
 	 * Add relevant global variable.
 	 */
 	void addGlobalVars(const StringSet &set) {
-		globalvars.insert(set.begin(), set.end());
+		globalvars |= ValueIDMap::getValueIDMap()->getIDs(set);
+	}
+
+	/**
+	 * Add relevant global variable.
+	 */
+	void addGlobalVars(const IDSet &set) {
+		globalvars |= set;
 	}
 
 	/**
 	 * Checks if the system call has a certain global variable.
+	 * (Not thread-safe, the lookup moves the iterator of the set)
 	 */
-	bool hasGlobalVar(std::string name) const {
-		return globalvars.find(name) != globalvars.end();
+	bool hasGlobalVar(std::string name) {
+		uint32_t id;
+		return ValueIDMap::getValueIDMap()->lookupID(name, id) && globalvars.test(id);
 	}
 
 	/**
@@ -178,12 +236,15 @@ public:
 	 * stored one.
 	 */
 	void intersectGlobalVars(const StringSet &set) {
-		StringSet interSet;
-		set_intersection(globalvars.cbegin(), globalvars.cend(), 
-				 set.begin(), set.end(), 
-				 std::inserter(interSet, interSet.begin()));
+		globalvars &= ValueIDMap::getValueIDMap()->getIDs(set);
+	}
 
-		globalvars = interSet;
+	/**
+	 * Intersects the given global variables with the 
+	 * stored one.
+	 */
+	void intersectGlobalVars(const IDSet &set) {
+		globalvars &= set;
 	}
 
 	/**
@@ -204,8 +265,8 @@ public:
 	 * Initersects the whole kernelCxtObj with the given one.
 	 */
 	virtual void intersect(const KernelContextObj &kernelCxtObj) {
-		intersectFunctions(kernelCxtObj.getFunctions());
-		intersectGlobalVars(kernelCxtObj.getGlobalVars());
+		intersectFunctions(kernelCxtObj.getFunctionIDs());
+		intersectGlobalVars(kernelCxtObj.getGlobalVarIDs());
 		maxCGDepth = maxCGDepth < kernelCxtObj.getMaxCGDepth() ? maxCGDepth : kernelCxtObj.getMaxCGDepth();
 	}
 
@@ -247,8 +308,8 @@ public:
 	virtual void dump() const {
 		llvm::outs() << "==================\n";
 		llvm::outs() << "KernelContextObj " << name << ":\n";
-		llvm::outs() << "Num functions= " << functions.size() << "\n";
-		llvm::outs() << "Num globalvars= " << globalvars.size() << "\n";
+		llvm::outs() << "Num functions= " << functions.count() << "\n";
+		llvm::outs() << "Num globalvars= " << globalvars.count() << "\n";
 		llvm::outs() << "MaxCGDepth= " << maxCGDepth << "\n";
 		llvm::outs() << "------------------\n";
 	}
@@ -256,8 +317,8 @@ public:
 protected:
 	std::string name;
 	StringSet cxtRoot;
-	StringSet functions;
-	StringSet globalvars;
+	IDSet functions;
+	IDSet globalvars;
 
 	uint32_t maxCGDepth;
 private:
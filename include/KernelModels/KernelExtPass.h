@@ -20,6 +20,14 @@ typedef std::set<std::string> StringSet;
  */
 class KernelExtPass : public llvm::ModulePass {		
 private:
+	// Categories of the kernel functions that are replaced.
+	enum FunctionCategory {
+		KALLOC 	= 1 << 0,
+		KFREE 	= 1 << 1,
+		KLOCK 	= 1 << 2,
+		KUNLOCK = 1 << 3
+	};
+
 	/** 
 	 * For all the kernel related allocations/frees we
 	 * remove the function definitions and replace them
@@ -7,6 +7,7 @@
 #include "Util/CallGraphAnalysis.h"
 #include "KernelModels/ContextBuilder.h"
 #include "KernelModels/KernelContext.h"
+#include "Util/IncrementalAnalysis.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/TypeBuilder.h"
@@ -29,7 +30,11 @@ class KernelPartitioner: public llvm::ModulePass {
 public:
 	static char ID;
 
-	KernelPartitioner(char id = ID): ModulePass(ID) { 
+	/**
+	 * If incremental is given, the dependencies of the context are hashed
+	 * before the module is reduced.
+	 */
+	KernelPartitioner(IncrementalAnalysis *incremental = nullptr): ModulePass(ID), incremental(incremental) { 
 		kernelCxt = KernelContext::getKernelContext();
 	} 
 
@@ -68,6 +73,12 @@ public:
 		return true;
 	}
 
+	/**
+	 * Collects the functions and global variables of the API and its relevant
+	 * initcalls. Only the initcalls of the context are filtered, the module stays untouched.
+	 */
+	void getRelevantValues(StringSet &relevantFuncs, StringSet &relevantGVs);
+
 	virtual const char* getPassName() const {
 		return "Module Partitioner Pass";
 	}
@@ -105,6 +116,8 @@ private:
 
 	PartitionerStat partStat;
 
+	IncrementalAnalysis *incremental;
+
 	llvm::Module *module;
 };
 
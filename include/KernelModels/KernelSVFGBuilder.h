@@ -126,18 +126,14 @@ private:
 	 * Function is part of the api.
 	 */
 	bool isAPIFunction(const llvm::Function* fun) {
-		if(fun && fun->hasName())
-			return kernelCxt->isAPIFunction(fun->getName());
-		return false;
+		return kernelCxt->isAPIFunction(fun);
 	}
 
 	/**
 	 * Function is part of the api context.
 	 */
 	bool inAPIContext(const llvm::Function* fun) {
-		if(fun && fun->hasName())
-			return kernelCxt->inAPIContext(fun->getName());
-		return false;
+		return kernelCxt->inAPIContext(fun);
 	}
 
 	/**
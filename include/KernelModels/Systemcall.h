@@ -21,8 +21,8 @@ public:
 	}
 
 	Systemcall(std::string 	name, 
-		   const StringSet &functions, 
-		   const StringSet &globalvars,
+		   const IDSet &functions, 
+		   const IDSet &globalvars,
 		   uint32_t maxCGDepth): 
 		   KernelContextObj(CONTEXT_TYPE::SYSCALL, name) { 
 		addToContextRoot(name);	
@@ -65,8 +65,8 @@ public:
 	virtual void dump() const {
 		llvm::outs() << "==================\n";
 		llvm::outs() << "Systemcall " << name << ":\n";
-		llvm::outs() << "Num functions= " << functions.size() << "\n";
-		llvm::outs() << "Num globalvars= " << globalvars.size() << "\n";
+		llvm::outs() << "Num functions= " << functions.count() << "\n";
+		llvm::outs() << "Num globalvars= " << globalvars.count() << "\n";
 		llvm::outs() << "MaxCGDepth= " << maxCGDepth << "\n";
 		llvm::outs() << "------------------\n";
 	}
@@ -0,0 +1,64 @@
+#ifndef VALUE_FLOW_PASS_H
+#define VALUE_FLOW_PASS_H
+
+#include "KernelModels/KernelSVFGBuilder.h"
+#include "SVF/MemoryModel/PAG.h"
+#include "SVF/MSSA/SVFGOPT.h"
+#include "SVF/WPA/Andersen.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Pass.h"
+#include "llvm/Support/raw_ostream.h"
+
+/***
+ * Builds the PAG, the andersen pointer analysis, MemSSA, the SVFG and the
+ * kernel node collections of the current context once. All checkers of the
+ * context require this pass and share its results.
+ */
+class ValueFlowPass: public llvm::ModulePass {
+public:
+	static char ID;
+
+	ValueFlowPass(char id = ID): ModulePass(ID), ander(nullptr), svfg(nullptr), svfgBuilder(nullptr) { } 
+
+	virtual ~ValueFlowPass() {
+		releaseMemory();
+	}
+
+	virtual bool runOnModule(llvm::Module& module);
+
+	/**
+	 * Releases the value-flow graph and the pointer analysis of the context.
+	 */
+	virtual void releaseMemory();
+
+	virtual const char* getPassName() const {
+		return "Value-Flow Pass";
+	}
+
+	virtual void getAnalysisUsage(llvm::AnalysisUsage& au) const {
+		au.setPreservesAll();
+	}
+
+	AndersenWaveDiff* getAndersen() const {
+		return ander;
+	}
+
+	SVFG* getSVFG() const {
+		return svfg;
+	}
+
+	KernelSVFGBuilder* getSVFGBuilder() const {
+		return svfgBuilder;
+	}
+
+	PTACallGraph* getPTACallGraph() const {
+		return ander->getPTACallGraph();
+	}
+
+private:
+	AndersenWaveDiff *ander;
+	SVFG *svfg;
+	KernelSVFGBuilder *svfgBuilder;
+};
+
+#endif // VALUE_FLOW_PASS_H
@@ -431,6 +431,14 @@ public:
 		delete symlnfo;
         symlnfo = NULL;
     }
+
+    /// Replace the singleton and its module, the previous ones are returned
+    static SymbolTableInfo* swapSymbolnfo(SymbolTableInfo* info, llvm::Module*& module) {
+        SymbolTableInfo* old = symlnfo;
+        symlnfo = info;
+        std::swap(mod, module);
+        return old;
+    }
     virtual ~SymbolTableInfo() {
         destroy();
     }
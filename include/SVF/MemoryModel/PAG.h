@@ -135,6 +135,12 @@ public:
             delete pag;
         pag = NULL;
     }
+    /// Replace the singleton, the previous one is returned
+    static PAG* swapPAG(PAG* p) {
+        PAG* old = pag;
+        pag = p;
+        return old;
+    }
     //@}
 
     /// Destructor
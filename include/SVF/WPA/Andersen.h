@@ -72,6 +72,18 @@ public:
     static double timeOfUpdateCallGraph;
     //@}
 
+    /// Results of a previous run, a hit replaces solving the constraints
+    class ResultCache {
+    public:
+        virtual ~ResultCache() {}
+        /// Key of the constraints of the analysis, computed before solving
+        virtual std::string getKey(Andersen* pta) = 0;
+        /// Seeds the analysis with the stored results of the key, false if there are none
+        virtual bool load(Andersen* pta, llvm::Module& module, const std::string& key) = 0;
+        /// Stores the results of the analysis, numOfInitialNodes are the PAG nodes before solving
+        virtual void store(Andersen* pta, const std::string& key, NodeID numOfInitialNodes) = 0;
+    };
+
     /// Constructor
     Andersen(PTATY type = Andersen_WPA)
         :  BVDataPTAImpl(type), consCG(NULL)
@@ -93,47 +105,63 @@ public:
         /// Initialization for the Solver
         initialize(module);
 
-        DBOUT(DGENERAL, llvm::outs() << analysisUtil::pasMsg("Start Solving Constraints\n"));
+        /// Cached results replace the solving
+        NodeID numOfInitialNodes = pag->getTotalNodeNum();
+        std::string cacheKey;
+        bool cached = false;
+        if (resultCache != NULL) {
+            cacheKey = resultCache->getKey(this);
+            cached = resultCache->load(this, module, cacheKey);
+        }
+
+        if (!cached) {
+            DBOUT(DGENERAL, llvm::outs() << analysisUtil::pasMsg("Start Solving Constraints\n"));
 
-        processAllAddr();
+            processAllAddr();
 //	omp_set_num_threads(1);
 
 //#pragma omp parallel
-        do {
+            do {
 //#pragma omp single
 //		{
-            numOfIteration++;
+                numOfIteration++;
 
 //            if(0 == numOfIteration % OnTheFlyIterBudgetForStat) {
 //                dumpStat();
 //            }
 
-            reanalyze = false;
+                reanalyze = false;
 //		}
 
-            /// Start solving constraints
-            solve();
+                /// Start solving constraints
+                solve();
 //#pragma omp barrier 
 
 //#pragma omp single 
 //	    {
-            double cgUpdateStart = stat->getClk();
-            if (updateCallGraph(getIndirectCallsites()))
-                reanalyze = true;
-            double cgUpdateEnd = stat->getClk();
-            timeOfUpdateCallGraph += (cgUpdateEnd - cgUpdateStart) / TIMEINTERVAL;
+                double cgUpdateStart = stat->getClk();
+                if (updateCallGraph(getIndirectCallsites()))
+                    reanalyze = true;
+                double cgUpdateEnd = stat->getClk();
+                timeOfUpdateCallGraph += (cgUpdateEnd - cgUpdateStart) / TIMEINTERVAL;
 //	    }
 
-	    if(!reanalyze)
-		    break;
+                if(!reanalyze)
+                    break;
 //#pragma omp barrier 
-	}while (true);
+            }while (true);
 //        } while (reanalyze);
-	
-        DBOUT(DGENERAL, llvm::outs() << analysisUtil::pasMsg("Finish Solving Constraints\n"));
+
+            DBOUT(DGENERAL, llvm::outs() << analysisUtil::pasMsg("Finish Solving Constraints\n"));
+        } else {
+            restoreCachedConstraints();
+        }
 
         /// finalize the analysis
         finalize();
+
+        if (resultCache != NULL && !cached)
+            resultCache->store(this, cacheKey, numOfInitialNodes);
     }
 
     /// Initialize analysis
@@ -202,6 +230,26 @@ public:
         return consCG;
     }
 
+    /// Cache of the results of previous runs
+    //@{
+    static void setResultCache(ResultCache* cache) {
+        resultCache = cache;
+    }
+    static ResultCache* getResultCache() {
+        return resultCache;
+    }
+    //@}
+
+    /// Restore a points-to set and an indirect call edge of a previous run
+    //@{
+    void addCachedPts(NodeID id, const PointsTo& pts);
+    void addCachedIndCall(llvm::CallSite cs, const llvm::Function* callee);
+    //@}
+
+    /// Derive the copy edges of the loads and stores from the restored points-to sets
+    /// and collapse the cycles, so the constraint graph matches the one of solving
+    void restoreCachedConstraints();
+
 protected:
     /// Reanalyze if any constraint value changed
     bool reanalyze;
@@ -260,6 +308,9 @@ protected:
     /// Constraint Graph
     ConstraintGraph* consCG;
 
+    /// Results of previous runs
+    static ResultCache* resultCache;
+
     /// Sanitize pts for field insensitive objects
     void sanitizePts() {
         for(ConstraintGraph::iterator it = consCG->begin(), eit = consCG->end(); it!=eit; ++it) {
@@ -375,6 +426,12 @@ public:
             delete diffWave;
         diffWave = NULL;
     }
+    /// Replace the singleton, the previous one is returned
+    static AndersenWaveDiff* swapAndersenWaveDiff(AndersenWaveDiff* ander) {
+        AndersenWaveDiff* old = diffWave;
+        diffWave = ander;
+        return old;
+    }
 
     virtual void handleCopyGep(ConstraintNode* node);
     virtual bool processCopy(NodeID node, const ConstraintEdge* edge);
@@ -85,6 +85,13 @@ public:
         fspta = NULL;
     }
 
+    /// Replace the flow-sensitive pointer analysis, the previous one is returned
+    static FlowSensitive* swapFSWPA(FlowSensitive* pta) {
+        FlowSensitive* old = fspta;
+        fspta = pta;
+        return old;
+    }
+
     /// We start from here
     virtual bool runOnModule(llvm::Module& module) {
         /// start analysis
@@ -34,29 +34,29 @@ public:
 		return reachNull;
 	}
 
-	bool isCall(const SVFGNode *src, const SVFGNode *dst) {
+	bool isCall(const SVFGNode *src, const SVFGNode *dst) const {
 		return getSVFG()->getSVFGEdge(src, dst, SVFGEdge::SVFGEdgeK::DirCall) ||
 			getSVFG()->getSVFGEdge(src, dst, SVFGEdge::SVFGEdgeK::IndCall);
 	}	
 
-	bool isRet(const SVFGNode *src, const SVFGNode *dst) {
+	bool isRet(const SVFGNode *src, const SVFGNode *dst) const {
 		return getSVFG()->getSVFGEdge(src, dst, SVFGEdge::SVFGEdgeK::DirRet) ||
 			getSVFG()->getSVFGEdge(src, dst, SVFGEdge::SVFGEdgeK::IndRet);
 	}	
 
-	bool isCall(NodeID src, NodeID dst) {
+	bool isCall(NodeID src, NodeID dst) const {
 		const SVFGNode *srcNode = getSVFG()->getSVFGNode(src);
 		const SVFGNode *dstNode = getSVFG()->getSVFGNode(dst);
 		return isCall(srcNode, dstNode);
 	}
 
-	bool isRet(NodeID src, NodeID dst) {
+	bool isRet(NodeID src, NodeID dst) const {
 		const SVFGNode *srcNode = getSVFG()->getSVFGNode(src);
 		const SVFGNode *dstNode = getSVFG()->getSVFGNode(dst);
 		return isRet(srcNode, dstNode);
 	}
 
-	const llvm::Instruction* getInstruction(const SVFGNode *node1, const SVFGNode *node2) {
+	const llvm::Instruction* getInstruction(const SVFGNode *node1, const SVFGNode *node2) const {
 		const llvm::Instruction *inst = nullptr;
 		const SVFG *svfg = getSVFG();
 
@@ -80,12 +80,12 @@ public:
 	/**
 	 * Checks if node1 may reaches node2.
 	 */
-	bool isReachable(const NodeIDPair &edge1, const NodeIDPair &edge2, bool dominates=false);
+	bool isReachable(const NodeIDPair &edge1, const NodeIDPair &edge2, bool dominates=false) const;
 
 	/**
 	 * Checks if item1 may reaches item2.
 	 */
-	bool isReachable(const KSrcSnkDPItem &item1, const KSrcSnkDPItem &item2, bool dominates=false);
+	bool isReachable(const KSrcSnkDPItem &item1, const KSrcSnkDPItem &item2, bool dominates=false) const;
 
 	const StringList& getAPIPath() const {
 		return apiPath;
@@ -100,7 +100,8 @@ public:
 	}
 
 private:
-	PTACFInfoBuilder CFBuilder;
+	// Only caches the dominator trees and loops.
+	mutable PTACFInfoBuilder CFBuilder;
 	bool reachNull;
 
 	// Path from the systemcall to the local variable.
@@ -505,7 +506,7 @@ public:
 	typedef std::map<NodeIDPair, KSrcSnkDPItem> ItemMap;
 
 	SrcSnkAnalysisContext(const SVFGNode* src, PathCondAllocator *pa, const SVFG* graph)
-		: AnalysisContext(src, pa, graph), maxPathID(0){
+		: AnalysisContext(src, pa, graph), maxPathID(0), solved(false), sorted(false) {
 	}
 
 	virtual ~SrcSnkAnalysisContext() { 
@@ -558,6 +559,13 @@ public:
 	 */
 	void sortPaths();
 
+	/**
+	 * Solves the conditions of the paths and removes the unreachable ones, if sort
+	 * is set the paths are sorted, too. Every step is done once, so the checkers that
+	 * share the context see the same paths.
+	 */
+	void solvePaths(bool sort);
+
 	/**
 	 * Removes the paths with sinks that have VFCond as false.
 	 */
@@ -594,6 +602,9 @@ private:
 	SVFGNodeCnt numPathMap;
 
 	unsigned int maxPathID;
+
+	bool solved;
+	bool sorted;
 };
 
 #endif // ANALYSIS_CONTEXT_H
@@ -0,0 +1,58 @@
+#ifndef ANALYSIS_SERVER_H
+#define ANALYSIS_SERVER_H
+
+#include "Util/BasicTypes.h"
+#include <functional>
+
+/**
+ * Keeps the parsed kernel and the kernel-wide analyses resident and serves
+ * analysis requests over a Unix domain socket. A request is a single line,
+ * e.g. "analyze sys_ioctl with double-free,use-after-free". Every request is
+ * handled by a forked process that shares the kernel copy-on-write, its
+ * reports are streamed back to the client, which is closed afterwards. At most
+ * maxHandlers requests are handled at once, further clients wait in the
+ * backlog of the socket. Only the user of the server may connect.
+ */
+class AnalysisServer {
+public:
+	typedef std::function<void(const std::string&)> RequestHandler;
+
+	AnalysisServer(const std::string &socketPath, uint32_t maxHandlers):
+		socketPath(socketPath), serverFd(-1), maxHandlers(maxHandlers > 0 ? maxHandlers : 1), numHandlers(0) { }
+
+	~AnalysisServer();
+
+	/**
+	 * Accepts requests until the server is terminated. Returns false if the
+	 * socket couldn't be created.
+	 */
+	bool run(RequestHandler handler);
+
+	/**
+	 * Checks if the current process handles a request.
+	 */
+	static bool isHandlingRequest();
+
+	/**
+	 * Sends a result of the current request to the client.
+	 */
+	static void sendResult(const std::string &msg);
+
+private:
+	/**
+	 * Reads the request of the client and passes it to the handler.
+	 */
+	void handleClient(int clientFd, RequestHandler handler);
+
+	/**
+	 * Reaps the finished handlers, if block is set it waits for at least one.
+	 */
+	void reapHandlers(bool block);
+
+	std::string socketPath;
+	int serverFd;
+	uint32_t maxHandlers;
+	uint32_t numHandlers;
+};
+
+#endif // ANALYSIS_SERVER_H
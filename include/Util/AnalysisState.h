@@ -0,0 +1,104 @@
+#ifndef ANALYSIS_STATE_H
+#define ANALYSIS_STATE_H
+
+#include "Util/BasicTypes.h"
+#include "Checker/UseAfterReturnChecker.h"
+#include "Checker/UseAfterReturnCheckerLite.h"
+
+class KMinerStat;
+class InitcallFactory;
+
+/**
+ * Holds the state of one analysis that SVF and K-Miner keep in singletons
+ * (PAG, pointer analyses, KernelContext, KMinerStat, ...), so it can be parked
+ * while another analysis uses the singletons. Only one state can be active in
+ * a process at a time, analyses that have to run concurrently use separate
+ * processes (see ContextWorkerPool).
+ *
+ * The kernel-wide lookups are shared by all states and aren't swapped:
+ * ValueIDMap, DebugInfoIndex, the function table of KernelCheckerAPI, the
+ * result cache of Andersen, the workers of InitcallFactory and the blacklist
+ * of LocalCallGraphAnalysis.
+ */
+class AnalysisState {
+public:
+	AnalysisState(): pag(nullptr), symInfo(nullptr), symModule(nullptr), ander(nullptr),
+		fspta(nullptr), kernelCxt(nullptr), kminerStat(nullptr), initcallFactory(nullptr),
+		pathCondAllocator(nullptr), uarGlobalWorklist(nullptr),
+		uarSchedThreads(nullptr), uarlGlobalWorklist(nullptr), uarlSchedThreads(nullptr) { }
+
+	/**
+	 * Releases all the analyses owned by the state, it is deactivated afterwards.
+	 */
+	~AnalysisState();
+
+	/**
+	 * Installs this state into the singletons, no other state may be active.
+	 */
+	void activate();
+
+	/**
+	 * Takes the state of the singletons back into this one.
+	 */
+	void deactivate();
+
+	/**
+	 * Releases the analyses of this state, it has to be active.
+	 */
+	void release();
+
+	/**
+	 * Get the currently active state, if any.
+	 */
+	static AnalysisState* getActiveState() {
+		return activeState;
+	}
+
+	/**
+	 * Activates a state for the lifetime of the scope.
+	 */
+	class Scope {
+	public:
+		Scope(AnalysisState &state): state(state) {
+			state.activate();
+		}
+
+		~Scope() {
+			// The state might have been released within the scope.
+			if(activeState == &state)
+				state.deactivate();
+		}
+
+	private:
+		AnalysisState &state;
+	};
+
+private:
+	// SVF
+	PAG *pag;
+	SymbolTableInfo *symInfo;
+	llvm::Module *symModule;
+	AndersenWaveDiff *ander;
+	FlowSensitive *fspta;
+
+	// K-Miner
+	KernelContext *kernelCxt;
+	KMinerStat *kminerStat;
+	InitcallFactory *initcallFactory;
+	PathCondAllocator *pathCondAllocator;
+
+	// Schedulers of the use-after-return checkers.
+	UARWorkList *uarGlobalWorklist;
+	BoolVec *uarSchedThreads;
+	UARLiteWorkList *uarlGlobalWorklist;
+	BoolVec *uarlSchedThreads;
+
+	/**
+	 * Exchanges this state with the one of the singletons.
+	 */
+	void swapState();
+
+	static AnalysisState *activeState;
+};
+
+#endif // ANALYSIS_STATE_H
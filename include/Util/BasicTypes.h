@@ -6,9 +6,17 @@
 #include <set>
 #include <map>
 #include "SVF/Util/BasicTypes.h" 
+#include <llvm/ADT/DenseSet.h>
 
 typedef std::list<std::string> StringList;
 typedef std::set<std::string> StringSet;
 typedef std::list<StringSet> StringSetList;
 
+// Set of the dense IDs of functions and global variables.
+typedef llvm::SparseBitVector<> IDSet;
+
+// Set of IDs that is filled once and then only queried, even by several threads.
+// (SparseBitVector::test moves an internal iterator)
+typedef llvm::DenseSet<uint32_t> IDLookup;
+
 #endif //BASIC_TYPES_H_
@@ -6,6 +6,7 @@
 #include "SVF/Util/PTACallGraph.h"
 #include "SVF/Util/AnalysisUtil.h"
 #include "Util/KMinerStat.h"
+#include "Util/ValueIDMap.h"
 
 using namespace llvm;
 
@@ -17,6 +18,7 @@ typedef std::set<const PTACallGraphNode*> CGNodeSet;
 typedef std::set<const llvm::Function*> FuncSet;
 typedef std::set<const llvm::Instruction*> InstSet;
 typedef std::map<std::string, InstSet> StrToInstSetMap;
+typedef std::map<std::string, uint32_t> StrToDepthMap;
 
 /***
  * Iterates above the PTACallGraph, starting from a given function, and
@@ -54,8 +56,7 @@ private:
 
 public:
 	LocalCallGraphAnalysis(PTACallGraph *callGraph):
-       			broad(true), forwardFilter(nullptr), backwardFilter(nullptr), 
-			actualDepth(0) { 
+       			broad(true), actualDepth(0), recordDepths(false) { 
 		setGraph(callGraph);
 		kminerStat = KMinerStat::createKMinerStat();
 		importBlackList();
@@ -73,6 +74,8 @@ public:
 	void reset() {
 		actualDepth = 0;
 		relevantGlobalVars.clear();
+		funcDepths.clear();
+		globalVarDepths.clear();
 		callerToCallSiteInst.clear();
 		forwardFuncSlice.clear();
 		forwardFuncPaths.clear();
@@ -89,6 +92,21 @@ public:
 	 */
 	void analyze(std::string startFunc, bool forward=true, bool broad=true, uint32_t maxDepth=0);
 
+	/**
+	 * Forwards the callgraph once from all the given functions (without treating function
+	 * pointers as calls) and records the minimal depth of every reached function and of
+	 * every global variable, which is the depth of the first function using it.
+	 */
+	void analyzeDepths(const StringSet &startFuncs);
+
+	const StrToDepthMap& getFuncDepths() const {
+		return funcDepths;
+	}
+
+	const StrToDepthMap& getGlobalVarDepths() const {
+		return globalVarDepths;
+	}
+
 	const StringSet& getForwardFuncSlice() const;
 	const StringSet& getBackwardFuncSlice() const;
 	const StrListSet& getForwardFuncPaths() const;
@@ -129,11 +147,11 @@ public:
 	}
 
 	void setForwardFilter(const StringSet &filter) {
-		forwardFilter = &filter;
+		forwardFilter = ValueIDMap::getValueIDMap()->getIDs(filter);
 	}
 
 	void setBackwardFilter(const StringSet &filter) {
-		backwardFilter = &filter;
+		backwardFilter = ValueIDMap::getValueIDMap()->getIDs(filter);
 	}
 
 	uint32_t getActualDepth() const {
@@ -152,6 +170,12 @@ public:
 
 	bool inBlackList(std::string funcName) const;
 
+	/**
+	 * Checks the function with the given ID against the blacklist, 
+	 * the outcome is cached.
+	 */
+	bool inBlackList(const llvm::Function *F, uint32_t id);
+
 	bool hasBlackList() const;
 
 	void importBlackList();
@@ -173,13 +197,23 @@ private:
 	StringSet backwardFuncSlice;
 	StrListSet backwardFuncPaths;
 
-	const StringSet *forwardFilter;
-	const StringSet *backwardFilter;
+	// IDs of the functions that aren't forwarded/backwarded.
+	IDSet forwardFilter;
+	IDSet backwardFilter;
 	CGNodeSet visitedSet;
 
+	// IDs of the functions that were checked against the blacklist and the ones found in it.
+	IDSet blackListChecked;
+	IDSet blackListed;
+
 	// Maps the callsite instructions of a funtion.
 	StrToInstSetMap callerToCallSiteInst;
 
+	// Minimal depths of the functions and global variables, set by analyzeDepths.
+	StrToDepthMap funcDepths;
+	StrToDepthMap globalVarDepths;
+	bool recordDepths;
+
 	KMinerStat *kminerStat;
 };
 
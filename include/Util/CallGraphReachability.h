@@ -0,0 +1,94 @@
+#ifndef CALLGRAPH_REACHABILITY_H
+#define CALLGRAPH_REACHABILITY_H
+
+#include "Util/BasicTypes.h"
+#include "SVF/Util/PTACallGraph.h"
+#include <llvm/ADT/BitVector.h>
+
+/**
+ * Reachability index of a PTACallGraph. The strongly connected components
+ * of the call graph are condensed to a DAG, for which the transitive callees
+ * and callers of each component are stored as plain bit vectors, so the
+ * queries only read the index and can be answered by concurrent threads.
+ * Calls into a barrier
+ * function are ignored, so e.g. the callers of a function can be collected
+ * up to the initcalls. The index has to be rebuilt once the call graph
+ * changes (see isValid).
+ */
+class CallGraphReachability {
+public:
+	CallGraphReachability(PTACallGraph *callGraph, const StringSet &barriers = StringSet());
+
+	~CallGraphReachability() { }
+
+	/**
+	 * Checks if the index still matches the call graph. Indirect call 
+	 * edges resolved after the index was built invalidate it.
+	 */
+	bool isValid(const PTACallGraph *callGraph) const {
+		return callGraph == this->callGraph && 
+			callGraph->getTotalNodeNum() == numNodes && 
+			callGraph->getNumOfResolvedIndCallEdge() == numIndCallEdges;
+	}
+
+	/**
+	 * Checks if the callee is (transitively) called by the caller. A 
+	 * function reaches itself.
+	 */
+	bool reaches(const llvm::Function *caller, const llvm::Function *callee) const;
+
+	/**
+	 * Get the names of all the functions (transitively) called by the function, including itself.
+	 */
+	StringSet getCalleeSlice(const llvm::Function *F) const;
+
+	/**
+	 * Get the names of all the functions (transitively) calling the function, including itself.
+	 */
+	StringSet getCallerSlice(const llvm::Function *F) const;
+
+	/**
+	 * Get the number of strongly connected components.
+	 */
+	uint32_t getNumSCCs() const {
+		return sccMembers.size();
+	}
+
+private:
+	/**
+	 * Condenses the call graph (Tarjan) and builds the transitive closures.
+	 */
+	void build();
+
+	/**
+	 * Get the names of the functions of the given components.
+	 */
+	StringSet getFunctionNames(const llvm::BitVector &sccs) const;
+
+	/**
+	 * Get the component of the function, false if it isn't part of the call graph.
+	 */
+	bool getSCC(const llvm::Function *F, uint32_t &scc) const;
+
+	PTACallGraph *callGraph;
+	Size_t numNodes;
+	Size_t numIndCallEdges;
+
+	// Call graph node of each function.
+	std::map<const llvm::Function*, NodeID> funcToNode;
+
+	// Call graph nodes, calls into them are ignored.
+	NodeBS barrierNodes;
+
+	// Component of each call graph node.
+	std::map<NodeID, uint32_t> nodeToSCC;
+
+	// Call graph nodes of each component.
+	std::vector<NodeBS> sccMembers;
+
+	// Components reachable from / reaching each component, including itself.
+	std::vector<llvm::BitVector> descendants;
+	std::vector<llvm::BitVector> ancestors;
+};
+
+#endif // CALLGRAPH_REACHABILITY_H
@@ -0,0 +1,110 @@
+#ifndef CONTEXT_WORKER_POOL_H
+#define CONTEXT_WORKER_POOL_H
+
+#include "Util/BasicTypes.h"
+#include <functional>
+#include <map>
+#include <vector>
+#include <sys/types.h>
+
+/**
+ * Distributes the contexts of a sweep over forked worker processes.
+ * Every context gets its own process that works in place on the copy-on-write
+ * kernel and the initcall pre-analysis, at most numWorkers run concurrently.
+ * The workers send their reports back to the parent over a pipe.
+ *
+ * With a memory budget the peak memory of a context is predicted from its size,
+ * the largest contexts are launched first and only as many run concurrently as
+ * fit into the budget. The prediction is corrected by the peak memory the
+ * finished contexts added to the copy-on-write memory of the parent.
+ */
+class ContextWorkerPool {
+public:
+	typedef std::function<void(const std::string&)> ContextJob;
+	typedef std::function<void(const std::string&)> ResultHandler;
+	typedef std::function<void(const std::string&, const std::string&)> FailureHandler;
+
+	/**
+	 * The memory budget is given in kB, no budget means a fixed number of workers.
+	 */
+	ContextWorkerPool(uint32_t numWorkers, uint64_t memBudget = 0): 
+		numWorkers(numWorkers), memBudget(memBudget), memPerElement(0) { }
+
+	~ContextWorkerPool() { }
+
+	/**
+	 * Analyzes all context roots with the given job and passes every
+	 * result of the workers to the handler. A worker that crashed or exited
+	 * with an error is passed to the failure handler together with the reason.
+	 * Returns after all workers finished.
+	 */
+	void run(const StringList &cxtRoots, ContextJob job, ResultHandler handler, 
+			FailureHandler failureHandler = nullptr);
+
+	/**
+	 * Checks if the current process is a worker of a pool.
+	 */
+	static bool isWorker();
+
+	/**
+	 * Sends a result of the current worker to the parent process.
+	 */
+	static void sendResult(const std::string &msg);
+
+	/**
+	 * Set the estimated size (functions and global variables) of a context,
+	 * its peak memory is predicted from it.
+	 */
+	void setContextSize(const std::string &cxtRoot, uint32_t size) {
+		cxtSizes[cxtRoot] = size;
+	}
+
+private:
+	struct Worker {
+		pid_t pid;
+		int fd;
+		std::string buffer;
+		std::string cxtRoot;
+		uint64_t predictedMem;
+		// Resident memory (kB) of the parent when the worker was forked.
+		uint64_t baseMem;
+	};
+
+	/**
+	 * Forks a worker that executes the given work and sends its results over a pipe.
+	 */
+	bool spawn(std::function<void()> work, const std::string &cxtRoot, uint64_t predictedMem);
+
+	/**
+	 * Reads the pending results of the worker. Returns false if the worker closed its pipe.
+	 */
+	bool readResults(Worker &worker, ResultHandler handler);
+
+	/**
+	 * Passes all complete results of the buffer to the handler.
+	 */
+	void handleResults(Worker &worker, ResultHandler handler);
+
+	/**
+	 * Waits for the termination of the worker and returns its peak memory in kB.
+	 * The reason is set if the worker terminated abnormally.
+	 */
+	uint64_t waitForWorker(const Worker &worker, std::string &reason);
+
+	/**
+	 * Get the predicted peak memory of the context in kB.
+	 */
+	uint64_t predictMemory(const std::string &cxtRoot) const;
+
+	// Peak memory (kB) per function or global variable until the first context finished.
+	static const uint64_t DEFAULT_MEM_PER_ELEMENT = 512;
+
+	uint32_t numWorkers;
+	uint64_t memBudget;
+	// Largest peak memory (kB) per function or global variable of the finished contexts.
+	uint64_t memPerElement;
+	std::map<std::string, uint32_t> cxtSizes;
+	std::vector<Worker> workers;
+};
+
+#endif // CONTEXT_WORKER_POOL_H
@@ -0,0 +1,97 @@
+#ifndef COST_MODEL_H
+#define COST_MODEL_H
+
+#include "Util/BasicTypes.h"
+#include <map>
+#include <vector>
+
+class KMinerStat;
+
+/**
+ * Predicts the analysis time of a context from the statistics of previous runs.
+ * Every analyzed context appends its features (functions, global variables and
+ * call-graph depth of the partitioned module, number of analyzed sources) and its
+ * duration to a history file. The model is a least-squares fit of the durations
+ * over the features.
+ */
+class CostModel {
+public:
+	struct Features {
+		uint32_t numFuncs = 0;
+		uint32_t numGVs = 0;
+		uint32_t cgDepth = 0;
+		uint32_t numSources = 0;
+	};
+
+	CostModel(const std::string &historyFile): historyFile(historyFile) { }
+
+	~CostModel() { }
+
+	/**
+	 * Reads the history and fits the model. Returns false if there is no history.
+	 */
+	bool load();
+
+	/**
+	 * Predicts the duration (sec) of the context. A context of the history is predicted
+	 * by its last features, an unknown one by the average features.
+	 */
+	double predict(const std::string &cxtName) const;
+
+	/**
+	 * Orders the contexts by their predicted duration, the longest first.
+	 */
+	void orderContexts(StringList &cxtRoots) const;
+
+	/**
+	 * Shares the deadline (sec) among the contexts in proportion to their predicted
+	 * duration, numParallel contexts are analyzed at the same time.
+	 */
+	void planBudgets(const StringList &cxtRoots, double deadline, uint32_t numParallel);
+
+	/**
+	 * Get the time budget (sec) of the context, 0 if it has none.
+	 */
+	double getTimeBudget(const std::string &cxtName) const {
+		auto iter = timeBudgets.find(cxtName);
+		return iter != timeBudgets.end() ? iter->second : 0;
+	}
+
+	/**
+	 * Appends the features and the duration of an analyzed context to the history.
+	 */
+	void record(const std::string &cxtName, const Features &features, double duration) const;
+
+	/**
+	 * Collects the features of the current context from the statistics.
+	 */
+	static Features collectFeatures(const KMinerStat &stat);
+
+private:
+	// Intercept and one weight per feature.
+	static const uint32_t NUM_WEIGHTS = 5;
+
+	/**
+	 * Fits the weights to the samples of the history.
+	 */
+	void fit();
+
+	/**
+	 * Applies the weights to the given features.
+	 */
+	double evaluate(const std::vector<double> &x) const;
+
+	/**
+	 * Get the features as a vector, starting with the intercept.
+	 */
+	static std::vector<double> toVector(const Features &features);
+
+	std::string historyFile;
+	std::vector<std::pair<std::vector<double>, double>> samples;
+	std::map<std::string, Features> lastFeatures;
+	std::vector<double> meanFeatures;
+	std::vector<double> weights;
+	std::map<std::string, double> timeBudgets;
+};
+
+#endif // COST_MODEL_H
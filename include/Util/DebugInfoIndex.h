@@ -0,0 +1,68 @@
+#ifndef DEBUG_INFO_INDEX_H
+#define DEBUG_INFO_INDEX_H
+
+#include "Util/BasicTypes.h"
+#include <llvm/IR/Module.h>
+#include <llvm/IR/ValueMap.h>
+#include <llvm/IR/DebugInfoMetadata.h>
+
+/***
+ * Maps the functions and global variables of a module to their debug info.
+ * The compile units of a module are walked once, when it is added before the
+ * analyses run in parallel. The lookups only read the maps, values of modules
+ * that weren't added walk the compile units without being cached. The maps
+ * don't follow replaceAllUsesWith (e.g. by undef when a module is reduced),
+ * deleted values are dropped.
+ */
+class DebugInfoIndex {
+private:
+	static DebugInfoIndex *debugInfoIndex;
+
+	DebugInfoIndex() { }
+
+	~DebugInfoIndex() { }
+
+public:
+	static DebugInfoIndex* createDebugInfoIndex() {
+		if(debugInfoIndex == nullptr)
+			debugInfoIndex = new DebugInfoIndex();
+		return debugInfoIndex;
+	}
+
+	static DebugInfoIndex* getDebugInfoIndex() {
+		return createDebugInfoIndex();
+	}
+
+	static void releaseDebugInfoIndex() {
+		if(debugInfoIndex != nullptr)
+			delete debugInfoIndex;
+		debugInfoIndex = nullptr;
+	}
+
+	/**
+	 * Get the subprogram of the function, NULL if it has no debug info.
+	 */
+	llvm::DISubprogram* getSubprogram(const llvm::Function *F);
+
+	/**
+	 * Get the debug info of the global variable, NULL if it has none.
+	 */
+	llvm::DIGlobalVariable* getGlobalVariable(const llvm::GlobalVariable *GV);
+
+	/**
+	 * Maps the functions and global variables of the module that aren't mapped yet.
+	 * Must not be called while the index is queried in parallel.
+	 */
+	void addModule(const llvm::Module &module);
+
+private:
+	// The keys are plain values, a function or variable might be replaced by undef.
+	struct ValueConfig : llvm::ValueMapConfig<const llvm::Value*> {
+		enum { FollowRAUW = false };
+	};
+
+	llvm::ValueMap<const llvm::Value*, llvm::DISubprogram*, ValueConfig> subprograms;
+	llvm::ValueMap<const llvm::Value*, llvm::DIGlobalVariable*, ValueConfig> globalVariables;
+};
+
+#endif // DEBUG_INFO_INDEX_H
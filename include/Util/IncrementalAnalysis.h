@@ -0,0 +1,73 @@
+#ifndef INCREMENTAL_ANALYSIS_H
+#define INCREMENTAL_ANALYSIS_H
+
+#include "Util/BasicTypes.h"
+#include <llvm/IR/Module.h>
+#include <map>
+#include <vector>
+
+/**
+ * Keeps the artifacts of previous runs to re-analyze only the contexts that
+ * changed. For every analyzed context the functions and global variables kept
+ * by the partitioner are stored with a hash of their unmodified IR, together
+ * with the report of the context. A context whose stored functions and variables are
+ * unchanged in the current kernel isn't analyzed again, its report is carried
+ * forward instead. Artifacts of runs with a different configuration (e.g. other
+ * checkers) are ignored.
+ */
+class IncrementalAnalysis {
+public:
+	IncrementalAnalysis(llvm::Module &module, const std::string &artifactDir, const std::string &config):
+		module(module), artifactDir(artifactDir), config(config), numCarriedForward(0) { }
+
+	~IncrementalAnalysis() { }
+
+	/**
+	 * Checks the artifacts of the context. If nothing changed, the stored report is
+	 * written to the report file and true is returned.
+	 */
+	bool carryForward(const std::string &cxtName);
+
+	/**
+	 * Hashes the functions and variables the current context depends on. Has to be
+	 * called before the partitioner changes the module.
+	 */
+	void recordDependencies(llvm::Module &cxtModule, const StringSet &functions, const StringSet &globalVars);
+
+	/**
+	 * Stores the recorded dependencies together with the report of the context.
+	 */
+	void storeContext(const std::string &cxtName, const std::string &report);
+
+	/**
+	 * Get the number of contexts whose report was carried forward.
+	 */
+	uint32_t getNumCarriedForward() const {
+		return numCarriedForward;
+	}
+
+private:
+	/**
+	 * Get the hash of a function or global variable of the unmodified kernel or
+	 * a copy of it, "-" if the module doesn't contain it.
+	 */
+	const std::string& getHash(llvm::Module &hashModule, char kind, const std::string &name);
+
+	/**
+	 * Get the file containing the artifacts of the context.
+	 */
+	std::string getArtifactFile(const std::string &cxtName) const;
+
+	llvm::Module &module;
+	std::string artifactDir;
+	std::string config;
+	uint32_t numCarriedForward;
+
+	// Hashes of the kernel, computed on demand.
+	std::map<std::pair<char, std::string>, std::string> hashes;
+
+	// Dependencies of the current context with their hashes.
+	std::vector<std::pair<std::pair<char, std::string>, std::string>> deps;
+};
+
+#endif // INCREMENTAL_ANALYSIS_H
@@ -123,6 +123,18 @@ public:
 		initcallFuncLimit = size;
 	}
 
+	uint32_t getNumKRFuncs() const {
+		return numKRFuncs;
+	}
+
+	uint32_t getNumKRGVs() const {
+		return numKRGVs;
+	}
+
+	uint32_t getARCGDepth() const {
+		return aRCGDepth;
+	}
+
 	std::string toString() const;
 
 private:
@@ -316,6 +328,15 @@ public:
 		kminerStat = nullptr;
 	}
 
+	/**
+	 * Replaces the statistic, the previous one is returned.
+	 */
+	static KMinerStat* swapKMinerStat(KMinerStat *stat) {
+		KMinerStat *old = kminerStat;
+		kminerStat = stat;
+		return old;
+	}
+
 	/**
 	 * Get the checker statistic as a string.
 	 */
@@ -416,6 +437,18 @@ public:
 		total_t = t;
 	}
 
+	double getTotalTime() const {
+		return total_t;
+	}
+
+	const PartitionerStat& getPartitionerStat() const {
+		return partitionerStat;
+	}
+
+	const CheckerStatList& getCheckerStats() const {
+		return checkerStats;
+	}
+
 private:
 	std::string moduleName = ""; 
 	uint32_t numThreads = 0;
@@ -18,6 +18,8 @@
 #include <llvm/IR/Dominators.h>	
 #include <llvm/Support/Debug.h>	
 #include <time.h>
+#include <sys/types.h>
+#include <memory>
 
 #define NUMDIGITS(n) ({n > 0 ? (int) log10 ((double) n) + 1 : 1;})
 
@@ -52,6 +54,13 @@ inline bool isUnlockExtCall(const llvm::Instruction *inst) {
 /// Removes the irrelevant functions and global variables from the module.
 void minimizeModule(llvm::Module &module, const StringSet &relevantFuncs, const StringSet &relevantGVs);
 
+/// Loads the bodies of the given functions of a lazily loaded module.
+uint32_t materializeFunctions(llvm::Module &module, const StringSet &funcNames, bool transitive);
+
+/// Creates a new module that only contains the relevant functions and global variables.
+std::unique_ptr<llvm::Module> extractModule(const llvm::Module &module, const StringSet &relevantFuncs,
+		const StringSet &relevantGVs);
+
 /// Removes the variables that are not a structure pointer or an array nor a structure containing a
 //  nother structure pointer.
 void filterNonStructTypes(const llvm::Module &module, StringSet &globalvars);
@@ -72,6 +81,13 @@ u32_t getSourceLineOfFunction(const llvm::Function *F);
 
 /// Seeks for an alias of a function name.
 std::string getAlias(const llvm::Module &module, std::string funcName);
+
+/// Forks an analysis process. The thread pool of OpenMP doesn't survive a fork,
+//  so the forked process runs its parallel regions with a single thread.
+pid_t forkAnalysisProcess();
+
+/// Get the number of threads the parallel regions of this process may use.
+uint32_t getMaxThreads(uint32_t numThreads);
 };
 
 #endif // KERNEL_ANALYSIS_UTIL_H
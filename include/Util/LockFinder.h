@@ -49,14 +49,13 @@ protected:
 	/**
 	 * Checks if the functions is either in the system call or the driver context.
 	 */
-	bool inAPIContext(std::string funcName) {
-		return kernelCxt->inAPIContext(funcName);
+	bool inAPIContext(const llvm::Function *F) {
+		return kernelCxt->inAPIContext(F);
 	}
 
 	virtual void backwardProcess(const CxtDPItem& item) {
 		const SVFGNode *node = getNode(item.getCurNodeID());
-		std::string funcName = svfgAnalysisUtil::getSVFGFuncName(node);
-		if(isa<AddrSVFGNode>(node) && inAPIContext(funcName))
+		if(isa<AddrSVFGNode>(node) && inAPIContext(svfgAnalysisUtil::getSVFGFunction(node)))
 			lockObjects.insert(node);
 		lockCxtNodes.insert(node);
 	}
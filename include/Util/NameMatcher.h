@@ -0,0 +1,64 @@
+#ifndef NAME_MATCHER_H
+#define NAME_MATCHER_H
+
+#include "Util/BasicTypes.h"
+#include <llvm/IR/Function.h>
+#include <llvm/IR/ValueMap.h>
+#include <map>
+
+/***
+ * Classifies names by the substrings they contain. The patterns of all
+ * categories are compiled into one Aho-Corasick automaton, so a name is
+ * classified in a single pass regardless of the number of patterns. The
+ * categories of a function are cached until the function is deleted.
+ */
+class NameMatcher {
+public:
+	NameMatcher(): compiled(false) {
+		nodes.push_back(Node());
+	}
+
+	~NameMatcher() { }
+
+	/**
+	 * Adds the patterns of a category, categories are bits of a mask.
+	 */
+	void addPatterns(const StringSet &patterns, uint32_t category);
+
+	/**
+	 * Get the categories of the patterns contained in the name.
+	 */
+	uint32_t match(const std::string &name);
+
+	/**
+	 * Get the categories of the patterns contained in the name of the function.
+	 */
+	uint32_t match(const llvm::Function *F);
+
+	/**
+	 * Checks if the name of the function contains a pattern of the categories.
+	 */
+	bool matches(const llvm::Function *F, uint32_t categories = ~0u) {
+		return (match(F) & categories) != 0;
+	}
+
+private:
+	struct Node {
+		std::map<char, uint32_t> next;
+		uint32_t fail = 0;
+		// Categories of the patterns ending here, including the ones of the fail links.
+		uint32_t categories = 0;
+	};
+
+	/**
+	 * Computes the fail links, once all patterns were added.
+	 */
+	void compile();
+
+	std::vector<Node> nodes;
+	bool compiled;
+
+	llvm::ValueMap<const llvm::Function*, uint32_t> cache;
+};
+
+#endif // NAME_MATCHER_H
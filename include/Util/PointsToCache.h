@@ -0,0 +1,49 @@
+#ifndef POINTS_TO_CACHE_H
+#define POINTS_TO_CACHE_H
+
+#include "SVF/WPA/Andersen.h"
+#include <llvm/IR/Module.h>
+#include <string>
+
+/**
+ * On-disk cache of andersen results. A cache entry is addressed by a hash of the
+ * PAG of the analyzed module and contains the points-to sets, the field nodes
+ * created while solving and the resolved indirect call edges. Contexts that
+ * share the same minimized module (e.g. reruns with other checkers) restore the
+ * stored results instead of solving the constraints, the copy edges and cycles of
+ * the constraint graph are derived from them afterwards.
+ */
+class PointsToCache : public Andersen::ResultCache {
+public:
+	PointsToCache(const std::string &cacheDir): cacheDir(cacheDir) { }
+
+	virtual ~PointsToCache() { }
+
+	/**
+	 * Hashes the nodes and edges of the PAG, the node IDs of the stored
+	 * results are only valid for the same PAG.
+	 */
+	virtual std::string getKey(Andersen *pta);
+
+	/**
+	 * Restores the stored results of the key.
+	 */
+	virtual bool load(Andersen *pta, llvm::Module &module, const std::string &key);
+
+	/**
+	 * Stores the results of the andersen analysis under the key.
+	 */
+	virtual void store(Andersen *pta, const std::string &key, NodeID numOfInitialNodes);
+
+private:
+	/**
+	 * Get the cache file of the given key.
+	 */
+	std::string getCacheFile(const std::string &key) const {
+		return cacheDir + "/" + key + ".pta";
+	}
+
+	std::string cacheDir;
+};
+
+#endif // POINTS_TO_CACHE_H
@@ -2,6 +2,7 @@
 #define REPORT_PASS_H
 
 #include "Util/KMinerStat.h"
+#include "Util/CostModel.h"
 #include <omp.h>
 
 #define REPORT_BANNER "######################################################\n" \
@@ -35,6 +36,9 @@ public:
 		// Write the statistics to a file.
 		makeReport();
 
+		// Keep the features of the context for the cost model.
+		lastFeatures = CostModel::collectFeatures(*stat);
+
 		// Reset the statistics.
 		stat->resetContextStat();
 		stat->resetPartitionerStat();
@@ -51,6 +55,25 @@ public:
 		au.setPreservesAll();
 	}
 
+	/**
+	 * Write message to the report file.
+	 */
+	static void writeToReport(std::string msg);
+
+	/**
+	 * Get the report of the last analyzed context.
+	 */
+	static const std::string& getLastReport() {
+		return lastReport;
+	}
+
+	/**
+	 * Get the features of the last analyzed context.
+	 */
+	static const CostModel::Features& getLastFeatures() {
+		return lastFeatures;
+	}
+
 private:
 	/**
 	 * Scans the exuting system in collect some system specific information
@@ -73,13 +96,12 @@ private:
 	 */
 	void makeReport();
 
-	/**
-	 * Write message to the report file.
-	 */
-	void writeToReport(std::string msg);
-
 	// Contains all log information found.
 	KMinerStat *stat;
+
+	static std::string lastReport;
+
+	static CostModel::Features lastFeatures;
 };
 
 
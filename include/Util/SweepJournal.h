@@ -0,0 +1,74 @@
+#ifndef SWEEP_JOURNAL_H
+#define SWEEP_JOURNAL_H
+
+#include "Util/BasicTypes.h"
+#include <map>
+
+/**
+ * Durable record of the progress of a sweep. Every context that is started,
+ * finished (together with its report) or failed is appended to the journal
+ * and synced to disk. A restarted sweep skips the contexts that were finished
+ * before and the ones that failed too often, e.g. because they crash the
+ * analysis or get killed by the OOM killer.
+ */
+class SweepJournal {
+public:
+	SweepJournal(const std::string &fileName): fileName(fileName), fd(-1) { }
+
+	~SweepJournal();
+
+	/**
+	 * Reads the records of previous runs and opens the journal for appending.
+	 * Returns false if the journal can't be written.
+	 */
+	bool open();
+
+	/**
+	 * Checks if the context was finished by a previous run or failed too often.
+	 */
+	bool isDone(const std::string &cxtName) const;
+
+	/**
+	 * Records that the analysis of the context starts.
+	 */
+	void beginContext(const std::string &cxtName);
+
+	/**
+	 * Records that the context was analyzed, together with its report.
+	 */
+	void finishContext(const std::string &cxtName, const std::string &report);
+
+	/**
+	 * Records that the analysis of the context failed.
+	 */
+	void failContext(const std::string &cxtName, const std::string &reason);
+
+	/**
+	 * Get the number of contexts that were finished by previous runs.
+	 */
+	uint32_t getNumFinished() const {
+		return finished.size();
+	}
+
+private:
+	/**
+	 * Appends a record and syncs it to disk.
+	 */
+	void append(const std::string &tag, const std::string &cxtName, const std::string &payload);
+
+	/**
+	 * Parses the records of previous runs.
+	 */
+	void load();
+
+	std::string fileName;
+	int fd;
+
+	StringSet finished;
+	std::map<std::string, uint32_t> numAttempts;
+
+	// A context that didn't finish that often is skipped.
+	static const uint32_t maxAttempts = 2;
+};
+
+#endif // SWEEP_JOURNAL_H
@@ -0,0 +1,132 @@
+#ifndef VALUE_ID_MAP_H
+#define VALUE_ID_MAP_H
+
+#include "Util/BasicTypes.h"
+#include <llvm/IR/Module.h>
+#include <llvm/IR/ValueMap.h>
+#include <llvm/Support/RWMutex.h>
+#include <unordered_map>
+
+/***
+ * Dense numbering of the functions and global variables of the kernel.
+ * The contexts store their functions and variables as bitsets of these IDs,
+ * names are only needed at the boundaries (reports, export, module reduction).
+ * The kernel is numbered and the numbering is frozen before the analyses run
+ * in parallel, the frozen names and IDs are read without a lock. Names that
+ * aren't part of it are numbered on demand behind a reader/writer lock, they
+ * are returned by value since numbering might move them. The functions and
+ * variables of the added modules are mapped to their IDs as well, so hot paths
+ * can look a value up without building its name. The mapping doesn't follow
+ * replaceAllUsesWith, so an undef that replaces an erased value never gets its
+ * ID. Modules are only added and reduced outside of parallel regions.
+ */
+class ValueIDMap {
+private:
+	static ValueIDMap *valueIDMap;
+
+	ValueIDMap(): frozen(false) { }
+
+	~ValueIDMap() { }
+
+public:
+	static ValueIDMap* createValueIDMap() {
+		if(valueIDMap == nullptr)
+			valueIDMap = new ValueIDMap();
+		return valueIDMap;
+	}
+
+	static ValueIDMap* getValueIDMap() {
+		return createValueIDMap();
+	}
+
+	static void releaseValueIDMap() {
+		if(valueIDMap != nullptr)
+			delete valueIDMap;
+		valueIDMap = nullptr;
+	}
+
+	/**
+	 * Numbers all the functions and global variables of the module and maps them
+	 * to their IDs. The mapping is dropped once a value is deleted.
+	 */
+	void addModule(const llvm::Module &module);
+
+	/**
+	 * Freezes the names numbered so far, they are looked up without the lock afterwards.
+	 */
+	void freeze() {
+		frozen = true;
+	}
+
+	/**
+	 * Get the number of frozen IDs, they are the same for every run on the same kernel.
+	 */
+	uint32_t getNumFrozenIDs() const {
+		return frozen ? names.size() : 0;
+	}
+
+	/**
+	 * Get the ID of the function or global variable. Values of modules that
+	 * weren't added are looked up by their name.
+	 */
+	uint32_t getID(const llvm::Value *value) {
+		auto iter = symbols.find(value);
+
+		if(iter != symbols.end())
+			return iter->second;
+
+		return getID(value->getName().str());
+	}
+
+	/**
+	 * Get the ID of the name, it is numbered if it's unknown.
+	 */
+	uint32_t getID(const std::string &name);
+
+	/**
+	 * Get the ID of the name without numbering it. Returns false if it's unknown.
+	 */
+	bool lookupID(const std::string &name, uint32_t &id) const;
+
+	/**
+	 * Get the name of the ID.
+	 */
+	std::string getName(uint32_t id) const {
+		if(frozen && id < names.size())
+			return names[id];
+
+		llvm::sys::SmartScopedReader<true> reader(lock);
+		assert(id < names.size() + lateNames.size() && "Unknown ID!");
+		return id < names.size() ? names[id] : lateNames[id - names.size()];
+	}
+
+	/**
+	 * Get the IDs of the names.
+	 */
+	IDSet getIDs(const StringSet &set);
+
+	/**
+	 * Get the names of the IDs.
+	 */
+	StringSet getNames(const IDSet &set) const;
+
+private:
+	// The keys are plain values, a reduced module replaces its erased values by undef.
+	struct ValueConfig : llvm::ValueMapConfig<const llvm::Value*> {
+		enum { FollowRAUW = false };
+	};
+
+	// Don't change once the numbering is frozen.
+	std::unordered_map<std::string, uint32_t> ids;
+	std::vector<std::string> names;
+	bool frozen;
+
+	// Names numbered after the freeze, guarded by the lock.
+	std::unordered_map<std::string, uint32_t> lateIDs;
+	std::vector<std::string> lateNames;
+	mutable llvm::sys::SmartRWMutex<true> lock;
+
+	llvm::ValueMap<const llvm::Value*, uint32_t, ValueConfig> symbols;
+};
+
+#endif // VALUE_ID_MAP_H
@@ -11,20 +11,22 @@ char DoubleFreeChecker::ID = 0;
 static RegisterPass<DoubleFreeChecker> DOUBLEFREECHECKER("double-free", "Double-Free Checker");
 
 void DoubleFreeChecker::analyze(llvm::Module &module) {
-	SrcSnkAnalysis::initialize(module);
-	SVFGNodeSet sources = getAllocNodes();
-	SVFGNodeSet sinks = getDeallocNodes();
-	sinks.insert(getNullStoreNodes().begin(), getNullStoreNodes().end());
+	SrcSnkAnalysis::initialize(module, getValueFlow());
+	SVFGNodeSet sources;
+	SVFGNodeSet sinks;
+	collectSourcesAndSinks(sources, sinks);
 	numAnalyzedVars = sources.size();
 	SrcSnkAnalysis::analyze(sources, sinks);
 }
 
-void DoubleFreeChecker::evaluate(SrcSnkAnalysisContext *curAnalysisCxt) {
-	const NodeIDPairVec &fsSinkPaths = curAnalysisCxt->getFlowSensSinkPaths(); 
+void DoubleFreeChecker::collectSourcesAndSinks(SVFGNodeSet &sources, SVFGNodeSet &sinks) {
+	sources = getAllocNodes();
+	sinks = getDeallocNodes();
+	sinks.insert(getNullStoreNodes().begin(), getNullStoreNodes().end());
+}
 
-	curAnalysisCxt->AllPathReachableSolve();
-	curAnalysisCxt->filterUnreachablePaths();
-	curAnalysisCxt->sortPaths();
+void DoubleFreeChecker::evaluate(const SrcSnkAnalysisContext *curAnalysisCxt) {
+	const NodeIDPairVec &fsSinkPaths = curAnalysisCxt->getFlowSensSinkPaths(); 
 
 	if(fsSinkPaths.size() == 0)
 		return;
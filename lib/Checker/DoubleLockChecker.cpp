@@ -12,7 +12,7 @@ static RegisterPass<DoubleLockChecker> DOUBLELOCKCHECKER("double-lock", "Double-
 
 
 void DoubleLockChecker::analyze(llvm::Module &module) {
-	SrcSnkAnalysis::initialize(module);
+	SrcSnkAnalysis::initialize(module, getValueFlow());
 	SVFGNodeSet sources = getLockObjNodes();
 	SVFGNodeSet sinks = getLockNodes();
 	sinks.insert(getUnlockNodes().begin(), getUnlockNodes().end());
@@ -20,13 +20,9 @@ void DoubleLockChecker::analyze(llvm::Module &module) {
 	SrcSnkAnalysis::analyze(sources, sinks);
 }
 
-void DoubleLockChecker::evaluate(SrcSnkAnalysisContext *curAnalysisCxt) {
+void DoubleLockChecker::evaluate(const SrcSnkAnalysisContext *curAnalysisCxt) {
 	const NodeIDPairVec &fsSinkPaths = curAnalysisCxt->getFlowSensSinkPaths(); 
 
-	curAnalysisCxt->AllPathReachableSolve();
-	curAnalysisCxt->filterUnreachablePaths();
-	curAnalysisCxt->sortPaths();
-
 	if(fsSinkPaths.size() == 0)
 		return;
 
@@ -1,8 +1,15 @@
 #include "Checker/KernelCheckerAPI.h"
+#include <llvm/Support/CommandLine.h>
+#include <llvm/Support/raw_ostream.h>
 #include <stdio.h>
+#include <fstream>
+#include <sstream>
 
 using namespace std;
 
+static llvm::cl::opt<std::string> KernelAPIFile("kernel-api", llvm::cl::init(""),
+		llvm::cl::desc("Data file of kernel allocation, free and lock functions (name and type per line)."));
+
 KernelCheckerAPI* KernelCheckerAPI::ckAPI = NULL;
 
 /// string and type pair
@@ -1051,5 +1058,41 @@ void KernelCheckerAPI::init() {
 		}
 		tdAPIMap[p->n]= p->t;
 	}
+
+	if(KernelAPIFile != "")
+		loadAPIFile(KernelAPIFile);
+}
+
+/*!
+ * Each line of the file contains a function name and its type (kalloc, kfree, klock or kunlock),
+ * lines starting with # are ignored.
+ */
+void KernelCheckerAPI::loadAPIFile(const std::string &fileName) {
+	std::ifstream in(fileName.c_str());
+	std::string line;
+
+	if(!in.good()) {
+		llvm::errs() << "Warning: Could not read the kernel api file " << fileName << "!\n";
+		return;
+	}
+
+	while(std::getline(in, line)) {
+		std::istringstream record(line);
+		std::string name, type;
+
+		if(!(record >> name >> type) || name[0] == '#')
+			continue;
+
+		if(type == "kalloc")
+			tdAPIMap[name] = CK_KALLOC;
+		else if(type == "kfree")
+			tdAPIMap[name] = CK_KFREE;
+		else if(type == "klock")
+			tdAPIMap[name] = CK_KLOCK;
+		else if(type == "kunlock")
+			tdAPIMap[name] = CK_KUNLOCK;
+		else
+			llvm::errs() << "Warning: Unknown type " << type << " of " << name << " in " << fileName << "!\n";
+	}
 }
 
@@ -11,18 +11,22 @@ char MemLeakChecker::ID = 0;
 static RegisterPass<MemLeakChecker> MEMLEAKCHECKER("leak", "Memory-Leak Checker");
 
 void MemLeakChecker::analyze(llvm::Module &module) {
-	SrcSnkAnalysis::initialize(module);
-	SVFGNodeSet sources = getAllocNodes();
-	SVFGNodeSet sinks = getDeallocNodes();
-	sinks.insert(getNullStoreNodes().begin(), getNullStoreNodes().end());
+	SrcSnkAnalysis::initialize(module, getValueFlow());
+	SVFGNodeSet sources;
+	SVFGNodeSet sinks;
+	collectSourcesAndSinks(sources, sinks);
 	numAnalyzedVars = sources.size();
 	SrcSnkAnalysis::analyze(sources, sinks);
 }
 
-void MemLeakChecker::evaluate(SrcSnkAnalysisContext *curAnalysisCxt) {
+void MemLeakChecker::collectSourcesAndSinks(SVFGNodeSet &sources, SVFGNodeSet &sinks) {
+	sources = getAllocNodes();
+	sinks = getDeallocNodes();
+	sinks.insert(getNullStoreNodes().begin(), getNullStoreNodes().end());
+}
+
+void MemLeakChecker::evaluate(const SrcSnkAnalysisContext *curAnalysisCxt) {
 	const ItemMap& sinkPaths = curAnalysisCxt->getSinkItems();
-	curAnalysisCxt->AllPathReachableSolve();
-	curAnalysisCxt->filterUnreachablePaths();
 
 	for(const auto &it : sinkPaths) {
 		const KSrcSnkDPItem &item = it.second;
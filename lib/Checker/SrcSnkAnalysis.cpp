@@ -11,7 +11,6 @@ static cl::opt<bool> PATH_SENSITIVE("path-sens", cl::init(false),
 		cl::desc("The analysis will be performed path-sensitive."));
 
 PathCondAllocator *SrcSnkAnalysis::pathCondAllocator = NULL;
-KernelSVFGBuilder *SrcSnkAnalysis::svfgBuilder = NULL;
 
 bool KSrcSnkDPItem::pathSensitive = false;
 
@@ -19,29 +18,105 @@ void SrcSnkAnalysis::analyze(const SVFGNodeSet &sources, const SVFGNodeSet &sink
 	this->sources = sources;
 	this->sinks = sinks;
 
+	if(fusionGroup) {
+		// The first analysis of the group already evaluated the sources of all.
+		if(!fusionGroup->analyzed)
+			analyzeFused();
+		return;
+	}
+
 	for(const auto &iter : sources) {
-		double tmp_t = omp_get_wtime();
-		setCurSlice(iter);
+		analyzeSource(iter);
+		curAnalysisCxt->solvePaths(needsPathOrder());
+		evaluate(curAnalysisCxt);
+	}
+}
+
+void SrcSnkAnalysis::fuse(const std::vector<SrcSnkAnalysis*> &analyses) {
+	std::shared_ptr<SrcSnkFusionGroup> group = std::make_shared<SrcSnkFusionGroup>();
+	group->analyses = analyses;
+
+	for(const auto &iter : analyses)
+		iter->fusionGroup = group;
+}
+
+void SrcSnkAnalysis::analyzeFused() {
+	const std::vector<SrcSnkAnalysis*> &analyses = fusionGroup->analyses;
+	std::vector<SVFGNodeSet> analysisSources(analyses.size());
+	std::vector<SVFGNodeSet> analysisSinks(analyses.size());
+	std::map<SVFGNodeSet, std::vector<uint32_t>> sinksToAnalyses;
+	SVFGNodeSet ownSources = sources;
+	SVFGNodeSet ownSinks = sinks;
+
+	for(uint32_t i = 0; i < analyses.size(); i++) {
+		SrcSnkAnalysis *analysis = analyses[i];
+
+		if(analysis != this)
+			analysis->initialize(*curModule, *curValueFlow);
 
+		analysis->collectSourcesAndSinks(analysisSources[i], analysisSinks[i]);
+		sinksToAnalyses[analysisSinks[i]].push_back(i);
+	}
+
+	// The sinks end the slices, analyses with other sinks (e.g. uses) need their own traversal.
+	for(const auto &iter : sinksToAnalyses) {
+		const std::vector<uint32_t> &members = iter.second;
+		bool sort = false;
+
+		sources.clear();
+		sinks = iter.first;
+
+		for(const auto &idx : members) {
+			sources.insert(analysisSources[idx].begin(), analysisSources[idx].end());
+			sort |= analyses[idx]->needsPathOrder();
+		}
+
+		for(const auto &src : sources) {
+			analyzeSource(src);
+			curAnalysisCxt->solvePaths(sort);
+
+			for(const auto &idx : members) {
+				SrcSnkAnalysis *analysis = analyses[idx];
+
+				if(analysisSources[idx].find(src) == analysisSources[idx].end())
+					continue;
+
+				// The context is owned by this analysis and only lent to the others.
+				analysis->curAnalysisCxt = curAnalysisCxt;
+				analysis->evaluate(curAnalysisCxt);
+			}
+		}
+	}
+
+	for(const auto &iter : analyses) {
+		if(iter != this)
+			iter->curAnalysisCxt = nullptr;
+	}
+
+	sources = ownSources;
+	sinks = ownSinks;
+	fusionGroup->analyzed = true;
+}
+
+void SrcSnkAnalysis::analyzeSource(const SVFGNode *source) {
+	setCurSlice(source);
+
+	VFPathCond cond;
+	VFPathVar pathVar(cond, source->getId());
+	KSrcSnkDPItem::setCxtSensitive();
+	KSrcSnkDPItem item(pathVar, source);
+	forwardTraverse(item);
+	clearVisitedMap();
+
+	if(PATH_SENSITIVE)
+		KSrcSnkDPItem::setPathSensitive();
+
+	for (const auto &iter : curAnalysisCxt->getVisitedSinks()) {
 		VFPathCond cond;
 		VFPathVar pathVar(cond, iter->getId());
-		KSrcSnkDPItem::setCxtSensitive();
 		KSrcSnkDPItem item(pathVar, iter);
-		forwardTraverse(item);
-		clearVisitedMap();
-
-		if(PATH_SENSITIVE)
-			KSrcSnkDPItem::setPathSensitive();
-
-		for (const auto &iter2 : curAnalysisCxt->getVisitedSinks()) {
-			VFPathCond cond;
-			VFPathVar pathVar(cond, iter2->getId());
-			KSrcSnkDPItem item(pathVar, iter2);
-			resetTimeout();
-			backwardTraverse(item);
-		}
-
-		evaluate(curAnalysisCxt);
+		resetTimeout();
+		backwardTraverse(item);
 	}
 }
 
@@ -210,6 +285,27 @@ StringList SrcSnkAnalysis::getAPIPath() {
 	if(!apiPath.empty())
 		return apiPath;
 
+	if(cgReachability == nullptr || !cgReachability->isValid(ptaCallGraph)) {
+		delete cgReachability;
+		cgReachability = new CallGraphReachability(ptaCallGraph, filter);
+	}
+
+	// Sources that no API function reaches don't need a backward traversal.
+	const llvm::Function *srcFunc = getSVFGFunction(curAnalysisCxt->getSource());
+	bool reachable = false;
+
+	for(const auto &iter : filter) {
+		if(cgReachability->reaches(ptaCallGraph->getModule()->getFunction(iter), srcFunc)) {
+			reachable = true;
+			break;
+		}
+	}
+
+	if(!reachable) {
+		curAnalysisCxt->setAPIPath(apiPath);
+		return apiPath;
+	}
+
 	LocalCallGraphAnalysis LCGA(ptaCallGraph);
 	// Dont backward further than the API.
 	LCGA.setBackwardFilter(filter);
@@ -11,21 +11,23 @@ char UseAfterFreeChecker::ID = 0;
 static RegisterPass<UseAfterFreeChecker> USEAFTERFREECHECKER("use-after-free", "Use-After-Free Checker");
 
 void UseAfterFreeChecker::analyze(llvm::Module &module) {
-	SrcSnkAnalysis::initialize(module);
-	SVFGNodeSet sources = getAllocNodes();
-	SVFGNodeSet sinks = getDeallocNodes();
-	sinks.insert(getUseNodes().begin(), getUseNodes().end());
-	sinks.insert(getNullStoreNodes().begin(), getNullStoreNodes().end());
+	SrcSnkAnalysis::initialize(module, getValueFlow());
+	SVFGNodeSet sources;
+	SVFGNodeSet sinks;
+	collectSourcesAndSinks(sources, sinks);
 	numAnalyzedVars = sources.size();
 	SrcSnkAnalysis::analyze(sources, sinks);
 }
 
-void UseAfterFreeChecker::evaluate(SrcSnkAnalysisContext *curAnalysisCxt) {
-	const NodeIDPairVec &fsSinkPaths = curAnalysisCxt->getFlowSensSinkPaths(); 
+void UseAfterFreeChecker::collectSourcesAndSinks(SVFGNodeSet &sources, SVFGNodeSet &sinks) {
+	sources = getAllocNodes();
+	sinks = getDeallocNodes();
+	sinks.insert(getUseNodes().begin(), getUseNodes().end());
+	sinks.insert(getNullStoreNodes().begin(), getNullStoreNodes().end());
+}
 
-	curAnalysisCxt->AllPathReachableSolve();
-	curAnalysisCxt->filterUnreachablePaths();
-	curAnalysisCxt->sortPaths();
+void UseAfterFreeChecker::evaluate(const SrcSnkAnalysisContext *curAnalysisCxt) {
+	const NodeIDPairVec &fsSinkPaths = curAnalysisCxt->getFlowSensSinkPaths(); 
 
 	if(fsSinkPaths.size() == 0)
 		return;
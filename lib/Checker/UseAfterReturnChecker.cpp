@@ -4,8 +4,10 @@
 #include "SVF/Util/GraphUtil.h"
 #include "Util/KernelAnalysisUtil.h"
 #include "Util/DebugUtil.h"
+#include "Util/NameMatcher.h"
 #include <ctime>
 #include <iomanip>
+#include <algorithm>
 #include <stdio.h>
 #include <omp.h>
 #include <stdlib.h>
@@ -105,18 +107,12 @@ void UseAfterReturnChecker::analyze(llvm::Module& module) {
 void UseAfterReturnChecker::initialize(llvm::Module& module) { 
 	initKernelContext();
 
-	double init_t = omp_get_wtime();
+	// PAG, MemSSA, PTACallGraph and SVFG are shared by all checkers.
+	ValueFlowPass &valueFlow = getValueFlow();
+	ander = valueFlow.getAndersen();
+	svfgBuilder = valueFlow.getSVFGBuilder();
 
-	// Creates PAG, MemSSA, PTACallGraph, SVFG
-	ander = AndersenWaveDiff::createAndersenWaveDiff(module);
-	init_t = omp_get_wtime(); 
-	
-	SVFG *svfg = new SVFGOPT(ander->getPTACallGraph());
-	init_t = omp_get_wtime(); 
-
-	svfgBuilder.build(svfg,ander);
-
-	setGraph(svfg);
+	setGraph(valueFlow.getSVFG());
 	
 	pag = PAG::getPAG();
 	dra = new DirRetAnalysis(getGraph());
@@ -124,6 +120,16 @@ void UseAfterReturnChecker::initialize(llvm::Module& module) {
 
 	findSinks();
 	initSrcs();
+
+	// The rest of the time budget of the context is shared by its variables.
+	deadline_t = 0;
+	if(kCxt->getTimeBudget() > 0) {
+		double numVars = stackSVFGNodes.size() + globalSVFGNodes.size();
+		double remaining_t = kCxt->getRemainingTime();
+
+		deadline_t = omp_get_wtime() + remaining_t;
+		max_t = remaining_t / std::max(1.0, numVars);
+	}
 }
 
 void UseAfterReturnChecker::initKernelContext() {
@@ -132,8 +138,8 @@ void UseAfterReturnChecker::initKernelContext() {
 }
 
 void UseAfterReturnChecker::initSrcs() {
-	stackSVFGNodes = svfgBuilder.getLocalNodes();
-	globalSVFGNodes = svfgBuilder.getGlobalNodes();
+	stackSVFGNodes = svfgBuilder->getLocalNodes();
+	globalSVFGNodes = svfgBuilder->getGlobalNodes();
 	filterStackSVFGNodes(stackSVFGNodes);
 }
 
@@ -865,7 +871,7 @@ void UseAfterReturnChecker::filterStackSVFGNodes(SVFGNodeSet &svfgNodes) {
 		svfgNode = *svfgNodeIterB;
 		F = getSVFGFunction(svfgNode);
 
-		if(!F || !F->hasName() || !kCxt->inAPIContext(F->getName())) {
+		if(!kCxt->inAPIContext(F)) {
 			svfgNodeIterB = svfgNodes.erase(svfgNodeIterB);
 			continue;
 		}
@@ -879,23 +885,16 @@ void UseAfterReturnChecker::filterStackSVFGNodes(SVFGNodeSet &svfgNodes) {
 
 void UseAfterReturnChecker::findSinks() {
 	StringSet deleteFunctions;	
+	NameMatcher matcher;
 
 	importSinks(deleteFunctions);
+	matcher.addPatterns(deleteFunctions, 1);
 
-	for(auto iter = deleteFunctions.begin(); iter != deleteFunctions.end(); ++iter) {
-		std::string funcSubName = *iter; 
-
-		for(auto iter2 = getModule().begin(); iter2 != getModule().end(); ++iter2) {
-			const llvm::Function *F = &*iter2;
-
-			if(F == nullptr)
-				continue;
+	for(auto iter = getModule().begin(); iter != getModule().end(); ++iter) {
+		const llvm::Function *F = &*iter;
 
-			std::string funcName = F->getName();
-
-			if(funcName.find(funcSubName) != std::string::npos)
-				sinks.insert(funcName);
-		}
+		if(matcher.matches(F))
+			sinks.insert(ValueIDMap::getValueIDMap()->getID(F));
 	}
 }
 
@@ -924,7 +923,7 @@ bool UseAfterReturnChecker::isSink(const SVFGNode *node) const {
 	if(!F)
 		return false;
 
-	return sinks.find(F->getName()) != sinks.end();
+	return sinks.count(ValueIDMap::getValueIDMap()->getID(F));
 }
 
 void UseAfterReturnChecker::setCurAnalysisCxt(const SVFGNode* src) {
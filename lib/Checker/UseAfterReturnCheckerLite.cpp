@@ -3,8 +3,10 @@
 #include "SVF/Util/GraphUtil.h"
 #include "Util/KernelAnalysisUtil.h"
 #include "Util/DebugUtil.h"
+#include "Util/NameMatcher.h"
 #include <ctime>
 #include <iomanip>
+#include <algorithm>
 #include <stdio.h>
 #include <omp.h>
 #include <stdlib.h>
@@ -84,24 +86,28 @@ void UseAfterReturnCheckerLite::analyze(llvm::Module& module) {
 void UseAfterReturnCheckerLite::initialize(llvm::Module& module) { 
 	initKernelContext();
 
-	double init_t = omp_get_wtime();
+	// PAG, MemSSA, PTACallGraph and SVFG are shared by all checkers.
+	ValueFlowPass &valueFlow = getValueFlow();
+	ander = valueFlow.getAndersen();
+	svfgBuilder = valueFlow.getSVFGBuilder();
 
-	// Creates PAG, MemSSA, PTACallGraph, SVFG
-	ander = AndersenWaveDiff::createAndersenWaveDiff(module);
-	init_t = omp_get_wtime(); 
-	
-	SVFG *svfg = new SVFGOPT(ander->getPTACallGraph());
-	init_t = omp_get_wtime(); 
-
-	svfgBuilder.build(svfg,ander);
-
-	setGraph(svfg);
+	setGraph(valueFlow.getSVFG());
 	
 	pag = PAG::getPAG();
 	max_t = UARTimeout;
 
 	findSinks();
 	initSrcs();
+
+	// The rest of the time budget of the context is shared by its variables.
+	deadline_t = 0;
+	if(kCxt->getTimeBudget() > 0) {
+		double numVars = stackSVFGNodes.size() + globalSVFGNodes.size();
+		double remaining_t = kCxt->getRemainingTime();
+
+		deadline_t = omp_get_wtime() + remaining_t;
+		max_t = remaining_t / std::max(1.0, numVars);
+	}
 }
 
 void UseAfterReturnCheckerLite::initKernelContext() {
@@ -110,8 +116,8 @@ void UseAfterReturnCheckerLite::initKernelContext() {
 }
 
 void UseAfterReturnCheckerLite::initSrcs() {
-	stackSVFGNodes = svfgBuilder.getLocalNodes();
-	globalSVFGNodes = svfgBuilder.getGlobalNodes();
+	stackSVFGNodes = svfgBuilder->getLocalNodes();
+	globalSVFGNodes = svfgBuilder->getGlobalNodes();
 	filterStackSVFGNodes(stackSVFGNodes);
 }
 
@@ -638,7 +644,7 @@ void UseAfterReturnCheckerLite::filterStackSVFGNodes(SVFGNodeSet &svfgNodes) {
 		svfgNode = *svfgNodeIterB;
 		F = getSVFGFunction(svfgNode);
 
-		if(!F || !F->hasName() || !kCxt->inAPIContext(F->getName())) {
+		if(!kCxt->inAPIContext(F)) {
 			svfgNodeIterB = svfgNodes.erase(svfgNodeIterB);
 			continue;
 		}
@@ -653,23 +659,16 @@ void UseAfterReturnCheckerLite::filterStackSVFGNodes(SVFGNodeSet &svfgNodes) {
 
 void UseAfterReturnCheckerLite::findSinks() {
 	StringSet deleteFunctions;	
+	NameMatcher matcher;
 
 	importSinks(deleteFunctions);
+	matcher.addPatterns(deleteFunctions, 1);
 
-	for(auto iter = deleteFunctions.begin(); iter != deleteFunctions.end(); ++iter) {
-		std::string funcSubName = *iter; 
-
-		for(auto iter2 = getModule().begin(); iter2 != getModule().end(); ++iter2) {
-			const llvm::Function *F = &*iter2;
-
-			if(F == nullptr)
-				continue;
+	for(auto iter = getModule().begin(); iter != getModule().end(); ++iter) {
+		const llvm::Function *F = &*iter;
 
-			std::string funcName = F->getName();
-
-			if(funcName.find(funcSubName) != std::string::npos)
-				sinks.insert(funcName);
-		}
+		if(matcher.matches(F))
+			sinks.insert(ValueIDMap::getValueIDMap()->getID(F));
 	}
 }
 
@@ -697,7 +696,7 @@ bool UseAfterReturnCheckerLite::isSink(const SVFGNode *node) const {
 	if(!F)
 		return false;
 
-	return sinks.find(F->getName()) != sinks.end();
+	return sinks.count(ValueIDMap::getValueIDMap()->getID(F));
 }
 
 void UseAfterReturnCheckerLite::setCurAnalysisCxt(const SVFGNode* src) {
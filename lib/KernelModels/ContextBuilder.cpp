@@ -13,6 +13,12 @@ void ContextBuilder::createContext(KernelContextObj *context) {
 	// Set the new context.
 	setContext(context);
 
+	// A lazily loaded kernel only contains the bodies that were needed so far.
+	if(materializeFunctions(module, context->getContextRoot(), true) > 0) {
+		delete pta;
+		pta = new PTACallGraph(&module);
+	}
+
 	// Define the call-graph analysis.
 	LocalCallGraphAnalysis *LCGA = new LocalCallGraphAnalysis(pta);
 
@@ -29,11 +35,43 @@ void ContextBuilder::createContext(KernelContextObj *context) {
 		context->addGlobalVars(relevantGVs);
 	}
 
-	outs() << "Reduction Level 1: " << context->getFunctions().size() << " Functions\n";
+	outs() << "Reduction Level 1: " << context->getNumFunctions() << " Functions\n";
 
 	delete LCGA;
 }
 
+std::map<std::string, uint32_t> ContextBuilder::estimateContextSizes(const StringList &cxtRootNames) {
+	const std::vector<std::string> workItems(cxtRootNames.begin(), cxtRootNames.end());
+	const uint32_t numRoots = workItems.size();
+	std::vector<uint32_t> sizes(numRoots, 0);
+	std::map<std::string, uint32_t> res;
+
+	// The module and the call graph are only read by the threads.
+	if(materializeFunctions(module, StringSet(cxtRootNames.begin(), cxtRootNames.end()), true) > 0) {
+		delete pta;
+		pta = new PTACallGraph(&module);
+	}
+
+	#pragma omp parallel firstprivate(numRoots)
+	{
+	LocalCallGraphAnalysis *LCGA = new LocalCallGraphAnalysis(pta);
+
+	// The first reduction level is cheap and bounds the size of the final context.
+	#pragma omp for schedule(dynamic)
+	for(int i=0; i < numRoots; ++i) {
+		LCGA->analyze(workItems[i], true, true, std::numeric_limits<uint32_t>::max());
+		sizes[i] = LCGA->getForwardFuncSlice().size() + LCGA->getRelevantGlobalVars().size();
+	}
+
+	delete LCGA;
+	}
+
+	for(uint32_t i = 0; i < numRoots; i++)
+		res[workItems[i]] = sizes[i];
+
+	return res;
+}
+
 void ContextBuilder::anderOpt(llvm::Module &module, KernelContextObj *context) {
 	analysisUtil::minimizeModule(module, context->getFunctions(), context->getGlobalVars());
 
@@ -57,7 +95,7 @@ void ContextBuilder::anderOpt(llvm::Module &module, KernelContextObj *context) {
 		context->setMaxCGDepth(maxCGDepth);
 	}
 
-	outs() << "Reduction Level 2: " << context->getFunctions().size() << " Functions\n";
+	outs() << "Reduction Level 2: " << context->getNumFunctions() << " Functions\n";
 
 	delete LCGA;
 	AndersenWaveDiff::releaseAndersenWaveDiff();
@@ -87,7 +125,7 @@ void ContextBuilder::flowOpt(llvm::Module &module, KernelContextObj *context) {
 		context->setMaxCGDepth(maxCGDepth);
 	}
 
-	outs() << "Reduction Level 3: " << context->getFunctions().size() << " Functions\n";
+	outs() << "Reduction Level 3: " << context->getNumFunctions() << " Functions\n";
 
 	delete LCGA;
 	FlowSensitive::releaseFSWPA();
@@ -96,7 +134,7 @@ void ContextBuilder::flowOpt(llvm::Module &module, KernelContextObj *context) {
 
 void ContextBuilder::minimizeContext(llvm::Module &module, KernelContextObj *context) {
 	// The call graph of the API doesn't has to be reduced.
-	if(context->getFunctions().size() < FUNCTIONLIMIT)
+	if(context->getNumFunctions() < FUNCTIONLIMIT)
 		return;
 
 	analysisUtil::minimizeModule(module, context->getFunctions(), context->getGlobalVars());
@@ -110,31 +148,37 @@ void ContextBuilder::minimizeContext(llvm::Module &module, KernelContextObj *con
 	StringSet relevantFuncs;
 	StringSet relevantGVs;
 
-	// Reduce the depth of the call graph as long as the functions limit wont be exceeded.
-	for(uint32_t depth = maxCGDepth; depth >= 0; depth--) {
+	// A single traversal from all root functions determines the minimal depth of every function.
+	LCGA->analyzeDepths(context->getContextRoot());
 
-		// Collect the contexts of all root functions.
-		for(const auto &iter : context->getContextRoot())  {
-			std::string rootFuncName = iter;
+	std::vector<uint32_t> histogram(LCGA->getActualDepth() + 1, 0);
 
-			LCGA->analyze(rootFuncName, true, false, depth);
+	for(const auto &iter : LCGA->getFuncDepths())
+		histogram[iter.second]++;
 
-			const StringSet &tmpFuncSet = LCGA->getForwardFuncSlice();
-			const StringSet &tmpGVSet = LCGA->getRelevantGlobalVars();
+	// The deepest call graph whose functions don't exceed the max number of functions.
+	// The roots are kept in any case.
+	uint32_t cutDepth = 0;
+	uint32_t numFuncs = 0;
 
-			relevantFuncs.insert(tmpFuncSet.begin(), tmpFuncSet.end());
-			relevantGVs.insert(tmpGVSet.begin(), tmpGVSet.end());
-		}
+	for(uint32_t depth = 0; depth < histogram.size() && depth <= maxCGDepth; depth++) {
+		numFuncs += histogram[depth];
 
-		// If the current number of relevant functions doesn't exceed the max number of functions,
-		// we dont have to decrease the callgraphDepth any further.
-		if(relevantFuncs.size() < FUNCTIONLIMIT) {
+		if(numFuncs >= FUNCTIONLIMIT)
 			break;
-		}
-		
-		relevantFuncs.clear();
-		relevantGVs.clear();
-	}	
+
+		cutDepth = depth;
+	}
+
+	for(const auto &iter : LCGA->getFuncDepths()) {
+		if(iter.second <= cutDepth)
+			relevantFuncs.insert(iter.first);
+	}
+
+	for(const auto &iter : LCGA->getGlobalVarDepths()) {
+		if(iter.second <= cutDepth)
+			relevantGVs.insert(iter.first);
+	}
 
 	context->intersectFunctions(relevantFuncs);
 	context->intersectGlobalVars(relevantGVs);
@@ -1,5 +1,6 @@
 #include "KernelModels/DriverBuilder.h"
 #include "SVF/Util/AnalysisUtil.h"
+#include <limits>
 
 using namespace llvm;
 using namespace analysisUtil;
@@ -11,6 +12,15 @@ void DriverBuilder::build(std::string cxtRootName) {
 	// Will be removed by the ContextBuilder.
 	Driver *driver = new Driver(cxtRootName);
 
+	// The API is defined by the callers of the driver functions, so all bodies are needed.
+	if(module.getMaterializer()) {
+		if(module.materializeAll())
+			errs() << "Warning: Could not load all functions of the module!\n";
+
+		delete pta;
+		pta = new PTACallGraph(&module);
+	}
+
 	// Find the functions inside the driver file. (API)
 	defineDriverAPI(driver);
 
@@ -19,7 +29,13 @@ void DriverBuilder::build(std::string cxtRootName) {
 }
 
 void DriverBuilder::optimizeContext() {
-	std::unique_ptr<llvm::Module> optModule = CloneModule(&module);
+	// Only copy the part of the kernel that belongs to the context.
+	std::unique_ptr<llvm::Module> optModule = analysisUtil::extractModule(module, context->getFunctions(), 
+			context->getGlobalVars());
+
+	// The call-graph analyses of the reductions look its values up by their IDs.
+	ValueIDMap::getValueIDMap()->addModule(*optModule.get());
+
 	anderOpt(*optModule.get(), context);
 	flowOpt(*optModule.get(), context);
 	minimizeContext(*optModule.get(), context);
@@ -51,23 +67,60 @@ void DriverBuilder::defineDriverAPI(Driver *driver) {
 		}
 	}
 
-	LocalCallGraphAnalysis *LCGA = new LocalCallGraphAnalysis(pta);
-
 	// Only add functions to the api that are not called by another api function.
+	for(const auto &iter : findAPIRoots(api))
+		driver->addToContextRoot(iter);
+}
+
+StringSet DriverBuilder::findAPIRoots(const StringSet &api) {
+	// A node reached by more than one api function.
+	const NodeID manyCallers = std::numeric_limits<NodeID>::max();
+	std::map<NodeID, NodeID> apiCaller;
+	std::vector<NodeID> worklist;
+	StringSet roots;
+
+	// Merges the api function(s) calling a node, true if that changed.
+	auto propagate = [&](NodeID dst, NodeID caller) {
+		auto iter = apiCaller.find(dst);
+
+		if(iter == apiCaller.end())
+			apiCaller[dst] = caller;
+		else if(iter->second != caller && iter->second != manyCallers)
+			iter->second = manyCallers;
+		else
+			return;
+
+		worklist.push_back(dst);
+	};
+
+	// An api function doesn't call itself, so only its callees are labeled.
 	for(const auto &iter : api) {
-		LCGA->analyze(iter, false, false, 100);
-		const StringSet &caller = LCGA->getBackwardFuncSlice();
-		bool found = false;
+		const PTACallGraphNode *node = pta->getCallGraphNode(module.getFunction(iter));
 
-		for(const auto &iter2 : caller) {
-			if(iter != iter2 && api.find(iter2) != api.end())
-				found = true;
-		}
-				
-		if(!found) {
-			driver->addToContextRoot(iter);
-		} 
+		for(auto edgeIter = node->OutEdgeBegin(); edgeIter != node->OutEdgeEnd(); ++edgeIter)
+			propagate((*edgeIter)->getDstID(), node->getId());
+	}
+
+	// Each node is labeled at most twice (one api function, many api functions).
+	while(!worklist.empty()) {
+		NodeID id = worklist.back();
+		NodeID caller = apiCaller[id];
+		const PTACallGraphNode *node = pta->getCallGraphNode(id);
+
+		worklist.pop_back();
+
+		for(auto edgeIter = node->OutEdgeBegin(); edgeIter != node->OutEdgeEnd(); ++edgeIter)
+			propagate((*edgeIter)->getDstID(), caller);
 	}
-	
-	delete LCGA;
+
+	for(const auto &iter : api) {
+		NodeID id = pta->getCallGraphNode(module.getFunction(iter))->getId();
+		auto callerIter = apiCaller.find(id);
+
+		// Only reached through a cycle back to itself.
+		if(callerIter == apiCaller.end() || callerIter->second == id)
+			roots.insert(iter);
+	}
+
+	return roots;
 }
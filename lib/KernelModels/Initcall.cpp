@@ -8,7 +8,8 @@ void getStreamOfStringSet(const StringSet &set, std::ostream &os) {
 	}
 }
 
-void getStringSetOfStream(std::istream &is, StringSet &set) {
+void getIDSetOfStream(std::istream &is, IDSet &set) {
+	ValueIDMap *valueIDMap = ValueIDMap::getValueIDMap();
 	uint32_t size = 0;
 
 	is >> size;
@@ -16,16 +17,16 @@ void getStringSetOfStream(std::istream &is, StringSet &set) {
 	for(int i=0; i < size; i++) {
 		std::string tmpStr;
 		is >> tmpStr;
-		set.insert(tmpStr);	
+		set.set(valueIDMap->getID(tmpStr));	
 	}
 }
 
 std::istream& operator>> (std::istream& is, Initcall &initcall) {
 	is >> initcall.name;
 	is >> initcall.level;
-	getStringSetOfStream(is, initcall.functions);
-	getStringSetOfStream(is, initcall.globalvars);
-	getStringSetOfStream(is, initcall.nondefvars);
+	getIDSetOfStream(is, initcall.functions);
+	getIDSetOfStream(is, initcall.globalvars);
+	getIDSetOfStream(is, initcall.nondefvars);
 	is >> initcall.maxCGDepth;
 
 	return is;
@@ -2,6 +2,8 @@
 #include "Util/PtrCallSetAnalysis.h"
 #include "Util/KernelAnalysisUtil.h"
 #include "Util/CallGraphAnalysis.h"
+#include "Util/CallGraphReachability.h"
+#include "Util/ContextWorkerPool.h"
 #include "SVF/MemoryModel/PointerAnalysis.h"
 #include "SVF/MemoryModel/PAGBuilder.h"
 #include "SVF/MemoryModel/MemModel.h"
@@ -12,10 +14,18 @@
 #include <fstream>
 #include <algorithm>
 #include <stdlib.h>
+#include <unordered_map>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstring>
 
 using namespace llvm;
 
-static cl::opt<std::string> PreAnalysisResults("initcall-contexts", cl::init("initcall_contexts.txt"),
+static cl::opt<std::string> PreAnalysisResults("initcall-contexts", cl::init("initcall_contexts.bin"),
 		cl::desc("Imports/exports the outcome of the first initcall analysis"));
 
 #define PREANALYSISRESULTS PreAnalysisResults != ""
@@ -24,6 +34,8 @@ InitcallFactory* InitcallFactory::initcallFactory = nullptr;
 uint32_t InitcallFactory::maxCGDepth = 0;
 uint32_t InitcallFactory::maxNumInitcallFunctions = 0;
 uint32_t InitcallFactory::maxNumInitcallGlobalVars = 0;
+uint32_t InitcallFactory::numWorkers = 1;
+uint64_t InitcallFactory::memBudget = 0;
 
 void InitcallFactory::findInitcalls() {
 //	outs() << "Find initcalls ...\n";
@@ -55,31 +67,20 @@ InitcallGroupList InitcallFactory::groupInitcallsByLimit(const InitcallMap &init
 	for(auto iter = initcalls.begin(); iter != initcalls.end(); ++iter) {
 		const Initcall &initcall = iter->second;
 		const std::string initcallName = initcall.getName();
-		const StringSet &initFuncs = initcall.getFunctions();
-		const StringSet &initGVs = initcall.getGlobalVars();
-		const StringSet &initNonDefVars = initcall.getNonDefVars();
+		const IDSet &initFuncs = initcall.getFunctionIDs();
+		const IDSet &initGVs = initcall.getGlobalVarIDs();
+		const IDSet &initNonDefVars = initcall.getNonDefVarIDs();
 		bool foundGroup = false;
 
 		for(auto iter2 = initcallGroups.begin(); iter2 != initcallGroups.end(); iter2++) {
 			InitcallGroup &initGroup = *iter2;
-			StringSet &gInitcalls = initGroup.initcalls;
-			StringSet &gInitFuncs = initGroup.functions;
-			StringSet &gInitGVs = initGroup.globalvars;
-			StringSet &gInitNonDefVars = initGroup.nondefvars; 
-			StringSet tmpFuncs, tmpGVs, tmpNonDefVars;
-
-			tmpFuncs.insert(initFuncs.begin(), initFuncs.end());
-			tmpFuncs.insert(gInitFuncs.begin(), gInitFuncs.end());
-			tmpGVs.insert(initGVs.begin(), initGVs.end());
-			tmpGVs.insert(gInitGVs.begin(), gInitGVs.end());
-			tmpNonDefVars.insert(initNonDefVars.begin(), initNonDefVars.end());
-			tmpNonDefVars.insert(gInitNonDefVars.begin(), gInitNonDefVars.end());
-
-			if(tmpFuncs.size() <= InitcallGroup::funcLimit) {
-				gInitcalls.insert(initcallName);
-				gInitFuncs = tmpFuncs;
-				gInitGVs = tmpGVs;
-				gInitNonDefVars = tmpNonDefVars;
+			IDSet tmpFuncs = initGroup.functions | initFuncs;
+
+			if(tmpFuncs.count() <= InitcallGroup::funcLimit) {
+				initGroup.initcalls.insert(initcallName);
+				initGroup.functions = tmpFuncs;
+				initGroup.globalvars |= initGVs;
+				initGroup.nondefvars |= initNonDefVars;
 				foundGroup = true;
 				break;
 			}
@@ -103,17 +104,14 @@ void InitcallFactory::groupInitcallsByLevel(const InitcallMap &initcalls) {
 	for(const auto &iter : initcalls) {
 		std::string initcallName = iter.first;
 		const Initcall &initcall = iter.second;
-		const StringSet &initFuncs = initcall.getFunctions();
-		const StringSet &initGVs = initcall.getGlobalVars();
-		const StringSet &initNonDefVars = initcall.getNonDefVars();
 		uint32_t level = initcall.getLevel();
 
-		InitcallGroup &group = getNextFreeInitcallGroup(level, initFuncs); 
+		InitcallGroup &group = getNextFreeInitcallGroup(level, initcall.getFunctionIDs()); 
 
 		group.initcalls.insert(initcallName);
-		group.functions.insert(initFuncs.begin(), initFuncs.end());
-		group.globalvars.insert(initGVs.begin(), initGVs.end());
-		group.nondefvars.insert(initNonDefVars.begin(), initNonDefVars.end());
+		group.functions |= initcall.getFunctionIDs();
+		group.globalvars |= initcall.getGlobalVarIDs();
+		group.nondefvars |= initcall.getNonDefVarIDs();
 	}	
 
 	// Sort the groups in the list by their levels.
@@ -130,27 +128,24 @@ void InitcallFactory::updateInitcallGroup(InitcallGroup &group) {
 
 	for(std::string initcallName : group.initcalls) {
 		const Initcall &initcall = initcalls[initcallName];
-		const StringSet &initcallFuncs = initcall.getFunctions();
-		const StringSet &initcallGlobalVars = initcall.getGlobalVars();
-		const StringSet &initcallNonDefVars = initcall.getNonDefVars();
 
-		group.functions.insert(initcallFuncs.begin(), initcallFuncs.end()); 
-		group.globalvars.insert(initcallGlobalVars.begin(), initcallGlobalVars.end()); 
-		group.nondefvars.insert(initcallNonDefVars.begin(), initcallNonDefVars.end()); 
+		group.functions |= initcall.getFunctionIDs(); 
+		group.globalvars |= initcall.getGlobalVarIDs(); 
+		group.nondefvars |= initcall.getNonDefVarIDs(); 
 	}
 }
 
 void InitcallFactory::handleInitcallGroup(InitcallGroup &group) {
-	StringSet &relevantFuncs = group.functions;
-	StringSet &relevantGVs = group.globalvars;
-	StringSet &relevantNonDefVars = group.nondefvars;
+	ValueIDMap *valueIDMap = ValueIDMap::getValueIDMap();
+	StringSet relevantFuncs = valueIDMap->getNames(group.functions);
+	StringSet relevantGVs = valueIDMap->getNames(group.globalvars);
 	InitcallMap groupInitcallMap;
 	uint32_t groupMaxCGDepth = 0;
 
-	std::unique_ptr<llvm::Module> InitcallModule = CloneModule(module);
+	std::unique_ptr<llvm::Module> InitcallModule = analysisUtil::extractModule(*module, relevantFuncs, relevantGVs);
 	llvm::Module &m = *InitcallModule.get();
 
-	analysisUtil::minimizeModule(m, relevantFuncs, relevantGVs);
+	valueIDMap->addModule(m);
 
 	double start = omp_get_wtime();
 	AndersenWaveDiff *anderdiff = AndersenWaveDiff::createAndersenWaveDiff(m); 
@@ -175,7 +170,7 @@ void InitcallFactory::handleInitcallGroup(InitcallGroup &group) {
 	updateInitcallGroup(group);
 
 	// Maps the functions that are used by the global structures (non defined variables). 
-	findFunctionsToPtr(fpta, fconsCG, pag, group.nondefvars);
+	findFunctionsToPtr(fpta, fconsCG, pag, valueIDMap->getNames(group.nondefvars));
 
 	if(groupMaxCGDepth > maxCGDepth)
 		maxCGDepth = groupMaxCGDepth;
@@ -195,14 +190,33 @@ void InitcallFactory::preAnalysis() {
 
 	findInitcalls();
 
+	// A lazily loaded kernel only contains the bodies that were needed so far.
+	if(analysisUtil::materializeFunctions(*module, getInitcallNames(), true) > 0) {
+		delete pta;
+		pta = new PTACallGraph(module);
+	}
+
 	// This will be a prev-analysis to find all kinds of relevant functions and globalvars. This
 	// contains also functions that were only defined as a function pointer.
 	InitcallMap tmpInitcalls = analyze(std::numeric_limits<uint32_t>::max(), true);
 
 	groupInitcallsByLevel(tmpInitcalls);
 
-	for(auto &group : initcallGroups)
-		handleInitcallGroup(group);	
+	// A group only depends on the groups of lower levels.
+	for(auto iter = initcallGroups.begin(); iter != initcallGroups.end();) {
+		std::vector<InitcallGroup*> levelGroups;
+		uint32_t level = iter->level;
+
+		for(; iter != initcallGroups.end() && iter->level == level; ++iter)
+			levelGroups.push_back(&*iter);
+
+		if(numWorkers > 1 && levelGroups.size() > 1) {
+			handleInitcallLevel(levelGroups);
+		} else {
+			for(auto group : levelGroups)
+				handleInitcallGroup(*group);
+		}
+	}
 
 	maxNumInitcallFunctions = getNumRelevantFunctions();
 	maxNumInitcallGlobalVars = getNumRelevantGlobalVars();
@@ -211,26 +225,180 @@ void InitcallFactory::preAnalysis() {
 		exportPreAnalysisResults();
 }
 
+void InitcallFactory::handleInitcallLevel(const std::vector<InitcallGroup*> &groups) {
+	ContextWorkerPool workerPool(numWorkers, memBudget);
+	std::map<std::string, InitcallGroup*> jobs;
+	StringList jobIDs;
+
+	for(auto group : groups) {
+		std::string jobID = std::to_string(group->ID);
+
+		jobs[jobID] = group;
+		jobIDs.push_back(jobID);
+
+		// The module of a group is cloned from its functions and global variables.
+		if(memBudget > 0)
+			workerPool.setContextSize(jobID, group->functions.count() + group->globalvars.count());
+	}
+
+	// The pool forks through analysisUtil::forkAnalysisProcess, a worker doesn't
+	// wait for the OpenMP threads of the pre-analysis that only exist in this process.
+	workerPool.run(jobIDs, [&](const std::string &jobID) {
+		InitcallGroup &group = *jobs[jobID];
+		handleInitcallGroup(group);
+
+		// Without a worker the group was handled by the process itself.
+		if(ContextWorkerPool::isWorker())
+			ContextWorkerPool::sendResult(getGroupResult(group));
+		else
+			jobs.erase(jobID);
+	}, [&](const std::string &msg) {
+		jobs.erase(std::to_string(mergeGroupResult(msg)));
+	});
+
+	if(jobs.empty())
+		return;
+
+	// The workers of these groups crashed or were killed, e.g. by an assertion in SVF or the
+	// OOM killer. They get one more worker, the same would take down the process itself.
+	StringList failedIDs;
+
+	for(const auto &iter : jobs) {
+		errs() << "Warning: Initcall group " << iter.first << " is handled again!\n";
+		failedIDs.push_back(iter.first);
+	}
+
+	workerPool.run(failedIDs, [&](const std::string &jobID) {
+		if(!ContextWorkerPool::isWorker())
+			return;
+
+		InitcallGroup &group = *jobs[jobID];
+		handleInitcallGroup(group);
+		ContextWorkerPool::sendResult(getGroupResult(group));
+	}, [&](const std::string &msg) {
+		jobs.erase(std::to_string(mergeGroupResult(msg)));
+	});
+
+	// Their initcalls stay without functions and variables, they aren't merged into any context.
+	for(const auto &iter : jobs)
+		errs() << "Warning: Initcall group " << iter.first << " failed again, it is skipped!\n";
+}
+
+std::string InitcallFactory::getGroupResult(const InitcallGroup &group) const {
+	ValueIDMap *valueIDMap = ValueIDMap::getValueIDMap();
+	std::ostringstream out;
+
+	// Names that were numbered by the worker itself are unknown to the parent, so names are sent.
+	out << group.ID << "\n";
+	out << maxCGDepth << "\n";
+	out << group.initcalls.size() << "\n";
+
+	for(const auto &iter : group.initcalls)
+		out << initcalls.at(iter);
+
+	out << group.nondefvars.count() << "\n";
+
+	for(const auto &iter : group.nondefvars) {
+		auto funcIter = nonDefVarFuncs.find(iter);
+		auto gvIter = nonDefVarGVs.find(iter);
+		StringSet functions, globalvars;
+
+		if(funcIter != nonDefVarFuncs.end())
+			functions = valueIDMap->getNames(funcIter->second);
+		if(gvIter != nonDefVarGVs.end())
+			globalvars = valueIDMap->getNames(gvIter->second);
+
+		out << valueIDMap->getName(iter) << "\n";
+		out << functions.size() << "\n";
+
+		for(const auto &iter2 : functions)
+			out << iter2 << "\n";
+
+		out << globalvars.size() << "\n";
+
+		for(const auto &iter2 : globalvars)
+			out << iter2 << "\n";
+	}
+
+	return out.str();
+}
+
+uint32_t InitcallFactory::mergeGroupResult(const std::string &msg) {
+	ValueIDMap *valueIDMap = ValueIDMap::getValueIDMap();
+	std::istringstream in(msg);
+	InitcallMap groupInitcallMap;
+	IDToIDSet groupNonDefVarFuncs;
+	IDToIDSet groupNonDefVarGVs;
+	uint32_t groupID = 0;
+	uint32_t groupMaxCGDepth = 0;
+	uint32_t numInitcalls = 0;
+	uint32_t numNonDefVars = 0;
+
+	in >> groupID;
+	in >> groupMaxCGDepth;
+	in >> numInitcalls;
+
+	for(uint32_t i=0; i < numInitcalls; ++i) {
+		Initcall initcall;
+		in >> initcall;
+		groupInitcallMap[initcall.getName()] = initcall;
+	}
+
+	in >> numNonDefVars;
+
+	for(uint32_t i=0; i < numNonDefVars; ++i) {
+		std::string nondefvar;
+		uint32_t num = 0;
+
+		in >> nondefvar;
+		in >> num;
+		uint32_t nondefvarID = valueIDMap->getID(nondefvar);
+		IDSet &funcSet = groupNonDefVarFuncs[nondefvarID];
+
+		for(uint32_t j=0; j < num; ++j) {
+			std::string function;
+			in >> function;
+			funcSet.set(valueIDMap->getID(function));
+		}
+
+		in >> num;
+		IDSet &gvSet = groupNonDefVarGVs[nondefvarID];
+
+		for(uint32_t j=0; j < num; ++j) {
+			std::string globalvar;
+			in >> globalvar;
+			gvSet.set(valueIDMap->getID(globalvar));
+		}
+	}
+
+	replaceInitcalls(groupInitcallMap);
+
+	for(auto &iter : initcallGroups) {
+		if(iter.ID == groupID)
+			updateInitcallGroup(iter);
+	}
+
+	mergeNonDefVarFunctions(groupNonDefVarFuncs, groupNonDefVarGVs);
+
+	if(groupMaxCGDepth > maxCGDepth)
+		maxCGDepth = groupMaxCGDepth;
+
+	return groupID;
+}
+
 void InitcallFactory::filterNonDefVars(InitcallMap &groupInitcalls) {
 	for(auto &iter : groupInitcalls) {
 		Initcall &initcall = iter.second;
-		StringSet &nonDefVars = initcall.getNonDefVars();
 		uint32_t level = initcall.getLevel();
 
 		for(auto &iter2 : initcallGroups) {
 			InitcallGroup &group = iter2; //initcallGroups[i];
-			StringSet &gInitNonDefVars = group.nondefvars;
-			StringSet tmpSet;
 
 			if(group.level >= level)
 				continue;
 			
 			// Removes all non defined global vars that were defined in lower level initcall.
-			std::set_difference(nonDefVars.begin(), nonDefVars.end(), 
-					    gInitNonDefVars.begin(), gInitNonDefVars.end(), 
-					    std::inserter(tmpSet, tmpSet.begin()));
-
-			nonDefVars = tmpSet;
+			initcall.removeNonDefVars(group.nondefvars);
 		}
 	}
 }
@@ -240,26 +408,29 @@ void InitcallFactory::findFunctionsToPtr(PTACallGraph 	 *pta,
 					 PAG 		 *pag, 
 					 const StringSet &globalvars) {
 
-	const uint32_t max = globalvars.size();
-	StrToStrSet globalvarToFuncs;
-	StrToStrSet globalvarToGVs;
+	ValueIDMap *valueIDMap = ValueIDMap::getValueIDMap();
+	const std::vector<std::string> workItems(globalvars.begin(), globalvars.end());
+	const uint32_t max = workItems.size();
+	IDToIDSet globalvarToFuncs;
+	IDToIDSet globalvarToGVs;
+
+	// The callers are collected up to the initcalls.
+	CallGraphReachability reachability(pta, getInitcallNames());
+
+	// The same functions are relevant for many global variables, so their 
+	// callers are shared by all threads.
+	StrToStrSet callerSlices;
 
 	#pragma omp parallel
 	{
 	PtrCallSetAnalysis *ptfAnalysis;
 
-	LocalCallGraphAnalysis *LCGA = new LocalCallGraphAnalysis(pta);
-	LCGA->setBackwardFilter(getInitcallNames());
-
 	#pragma omp critical (new_ptfAnalysis)
 	ptfAnalysis = new PtrCallSetAnalysis(consCG, pag);
 
-	#pragma omp for
+	#pragma omp for schedule(dynamic)
 	for(int i=0; i < max; ++i) {
-		auto iter = globalvars.begin();
-		advance(iter, i);
-
-		std::string globalVarName = *iter;
+		const std::string &globalVarName = workItems[i];
 		ptfAnalysis->analyze(globalVarName);
 		StringSet &relevantFuncs = ptfAnalysis->getRelevantFunctions();		
 		StringSet &relevantGVs = ptfAnalysis->getRelevantGlobalVars();		
@@ -267,26 +438,40 @@ void InitcallFactory::findFunctionsToPtr(PTACallGraph 	 *pta,
 
 		// Add the functions that call the relevant functions.
 		for(auto iter : tmpSet) {
-			LCGA->analyze(iter, false, false, std::numeric_limits<uint32_t>::max());
-			const StrListSet &paths = LCGA->getBackwardFuncPaths();
+			const StringSet *callers = nullptr;
 
-			for(const auto &iter2 : paths) {
-				const StringList &path = iter2;
-				relevantFuncs.insert(path.begin(), path.end());
+			#pragma omp critical (callerSlices)
+			{
+			auto sliceIter = callerSlices.find(iter);
+			if(sliceIter != callerSlices.end())
+				callers = &sliceIter->second;
+			}
+
+			// The elements of the map stay in place, so the slice can be read outside of the critical section.
+			if(!callers) {
+				StringSet slice = reachability.getCallerSlice(pta->getModule()->getFunction(iter));
+
+				#pragma omp critical (callerSlices)
+				callers = &callerSlices.insert(std::make_pair(iter, std::move(slice))).first->second;
 			}
+
+			relevantFuncs.insert(callers->begin(), callers->end());
 		}
 
+		uint32_t globalVarID = valueIDMap->getID(globalVarName);
+		IDSet funcIDs = valueIDMap->getIDs(relevantFuncs);
+		IDSet gvIDs = valueIDMap->getIDs(relevantGVs);
+
 		#pragma omp critical (nonDefVarFuncs)
-		globalvarToFuncs[globalVarName] = relevantFuncs;
+		globalvarToFuncs[globalVarID] = std::move(funcIDs);
 		#pragma omp critical (nonDefVarGVs)
-		globalvarToGVs[globalVarName] = relevantGVs;
+		globalvarToGVs[globalVarID] = std::move(gvIDs);
 	}
 
 	#pragma omp barrier
 
 	#pragma omp critical (free_ptfAnalysis)
 	delete ptfAnalysis;
-	delete LCGA;
 	}
 
 	mergeNonDefVarFunctions(globalvarToFuncs, globalvarToGVs);
@@ -309,7 +494,8 @@ uint32_t InitcallFactory::analyze(const StringSet &initcallNames,
 				  bool broad,
 				  InitcallMap &res) {
 
-	const uint32_t numInitcalls = initcallNames.size();
+	const std::vector<std::string> workItems(initcallNames.begin(), initcallNames.end());
+	const uint32_t numInitcalls = workItems.size();
 	uint32_t maxDepth = 0;
 	uint32_t tmpDepth = 0;
 
@@ -320,12 +506,9 @@ uint32_t InitcallFactory::analyze(const StringSet &initcallNames,
 
 	// Starting from the some given functions(e.g. syscalls) we calc. 
 	// all the relevant functions.
-	#pragma omp for
+	#pragma omp for schedule(dynamic)
 	for(int i=0; i < numInitcalls; ++i) {
-		auto initcallIter = initcallNames.begin();
-		advance(initcallIter, i);
-
-		std::string initcallName = *initcallIter;
+		const std::string &initcallName = workItems[i];
 		const Initcall &origInitcall = initcalls[initcallName];
 
 		LCGA->analyze(initcallName, true, broad, depth);
@@ -377,52 +560,375 @@ uint32_t InitcallFactory::analyze(const StringSet &initcallNames,
 }
 
 StringSet InitcallFactory::getAllInitcallFuncs(const InitcallMap &initcalls) const {
-	StringSet functions;
+	IDSet functions;
 
-	for(auto iter : initcalls) {
+	for(const auto &iter : initcalls) {
 		const Initcall &initcall = iter.second;
-		functions.insert(initcall.getFunctions().begin(), initcall.getFunctions().end());
+		functions |= initcall.getFunctionIDs();
 	}	
 
-	return functions;
+	return ValueIDMap::getValueIDMap()->getNames(functions);
 }
 
 StringSet InitcallFactory::getAllInitcallGlobalVars(const InitcallMap &initcalls) const {
-	StringSet globalvars;
+	IDSet globalvars;
 
-	for(auto iter : initcalls) {
+	for(const auto &iter : initcalls) {
 		const Initcall &initcall = iter.second;
-		globalvars.insert(initcall.getGlobalVars().begin(), initcall.getGlobalVars().end());
+		globalvars |= initcall.getGlobalVarIDs();
 	}	
 
-	return globalvars;
+	return ValueIDMap::getValueIDMap()->getNames(globalvars);
 }
 
 StringSet InitcallFactory::getAllInitcallNonDefVars(const InitcallMap &initcalls) const {
-	StringSet nondefvars;
+	IDSet nondefvars;
 
-	for(auto iter : initcalls) {
+	for(const auto &iter : initcalls) {
 		const Initcall &initcall = iter.second;
-		nondefvars.insert(initcall.getNonDefVars().begin(), initcall.getNonDefVars().end());
+		nondefvars |= initcall.getNonDefVarIDs();
 	}	
 
-	return nondefvars;
+	return ValueIDMap::getValueIDMap()->getNames(nondefvars);
+}
+
+void InitcallFactory::buildNonDefVarIndex() {
+	nonDefVarIndex.clear();
+
+	for(const auto &iter : initcalls) {
+		const Initcall &initcall = iter.second;
+
+		for(const auto &nondefvar : initcall.getNonDefVarIDs()) {
+			NonDefVarUse use;
+
+			use.initcall = iter.first;
+
+			auto funcIter = nonDefVarFuncs.find(nondefvar);
+			if(funcIter != nonDefVarFuncs.end())
+				use.functions = initcall.getFunctionIDs() & funcIter->second;
+
+			auto gvIter = nonDefVarGVs.find(nondefvar);
+			if(gvIter != nonDefVarGVs.end())
+				use.globalvars = initcall.getGlobalVarIDs() & gvIter->second;
+
+			nonDefVarIndex[nondefvar].push_back(use);
+		}
+	}
 }
 
 StringSet InitcallFactory::getAllNonDefVarFuncs() const {
-	StringSet functions;
+	IDSet functions;
 
-	for(auto iter : nonDefVarFuncs) {
-		const StringSet &tmpFuncs = iter.second;
-		functions.insert(tmpFuncs.begin(), tmpFuncs.end());
-	}	
+	for(const auto &iter : nonDefVarFuncs)
+		functions |= iter.second;
 
-	return functions;
+	return ValueIDMap::getValueIDMap()->getNames(functions);
+}
+
+namespace {
+
+/**
+ * Identity of the bitcode file, the hash is only computed again once it changes.
+ */
+struct FileIdentity {
+	uint64_t dev;
+	uint64_t inode;
+	uint64_t size;
+	int64_t mtime;
+	int64_t mtimeNSec;
+
+	bool read(const std::string &fileName) {
+		struct stat st;
+
+		if(stat(fileName.c_str(), &st) != 0)
+			return false;
+
+		dev = st.st_dev;
+		inode = st.st_ino;
+		size = st.st_size;
+		mtime = st.st_mtim.tv_sec;
+		mtimeNSec = st.st_mtim.tv_nsec;
+		return true;
+	}
+
+	bool operator==(const FileIdentity &other) const {
+		return dev == other.dev && inode == other.inode && size == other.size &&
+			mtime == other.mtime && mtimeNSec == other.mtimeNSec;
+	}
+};
+
+/**
+ * Header of the binary pre-analysis results. It is followed by the string offsets
+ * (numStrings + 1), the strings, the initcalls and the non defined variables. A
+ * name below numKernelIDs is an ID of the frozen kernel numbering, the others are
+ * numKernelIDs + their index into the string table.
+ *
+ * initcall: name, level, maxCGDepth, #functions, #globalvars, #nondefvars, <names>
+ * nondefvar: name, #functions, #globalvars, <names>
+ */
+struct PreAnalysisHeader {
+	char magic[4];
+	uint32_t version;
+	uint8_t moduleHash[16];
+	FileIdentity moduleFile;
+	uint32_t numKernelIDs;
+	uint32_t numStrings;
+	uint32_t numInitcalls;
+	uint32_t numNonDefVars;
+	uint32_t maxCGDepth;
+	uint32_t maxNumInitcallFunctions;
+	uint32_t maxNumInitcallGlobalVars;
+	uint32_t reserved;
+};
+
+static const char PREANALYSIS_MAGIC[4] = {'K', 'M', 'I', 'C'};
+
+// Has to be increased whenever the pre-analysis or the format changes.
+static const uint32_t PREANALYSIS_VERSION = 3;
+
+/**
+ * Reads the words of the mapped file, every access is checked against its end.
+ */
+class WordReader {
+public:
+	WordReader(const uint32_t *pos, const uint32_t *end): pos(pos), end(end) { }
+
+	bool read(uint32_t &word) {
+		if(pos >= end)
+			return false;
+
+		word = *pos++;
+		return true;
+	}
+
+	bool read(uint64_t num, const uint32_t *&words) {
+		if((uint64_t)(end - pos) < num)
+			return false;
+
+		words = pos;
+		pos += num;
+		return true;
+	}
+
+private:
+	const uint32_t *pos;
+	const uint32_t *end;
+};
+
+/**
+ * Turns IDs into the names of the export. Kernel IDs are kept, only the
+ * names numbered after the freeze go into the string table.
+ */
+class StringTable {
+public:
+	StringTable(uint32_t numKernelIDs): numKernelIDs(numKernelIDs) { }
+
+	uint32_t getIndex(uint32_t id) {
+		if(id < numKernelIDs)
+			return id;
+
+		auto iter = indices.find(id);
+
+		if(iter != indices.end())
+			return iter->second;
+
+		uint32_t index = numKernelIDs + strings.size();
+		indices[id] = index;
+		strings.push_back(ValueIDMap::getValueIDMap()->getName(id));
+
+		return index;
+	}
+
+	void add(const IDSet &set, std::vector<uint32_t> &words) {
+		for(const auto &iter : set)
+			words.push_back(getIndex(iter));
+	}
+
+	const std::vector<std::string>& getStrings() const {
+		return strings;
+	}
+
+private:
+	uint32_t numKernelIDs;
+	std::unordered_map<uint32_t, uint32_t> indices;
+	std::vector<std::string> strings;
+};
+
+}
+
+bool InitcallFactory::getModuleHash(uint8_t hash[16]) const {
+	MD5 md5;
+	MD5::MD5Result result;
+	ErrorOr<std::unique_ptr<MemoryBuffer>> buffer = MemoryBuffer::getFile(module->getModuleIdentifier());
+
+	// The module is hashed by its contents, a copy of the kernel at another path keeps the hash.
+	if(!buffer)
+		return false;
+
+	md5.update((*buffer)->getBuffer());
+	md5.final(result);
+	memcpy(hash, &result[0], 16);
+	return true;
 }
 
 bool InitcallFactory::importPreAnalysisResults() {
 	std::string fileName = PreAnalysisResults;
-	std::ifstream in(fileName.c_str(), std::ifstream::in);
+	int fd = open(fileName.c_str(), O_RDONLY);
+	struct stat st;
+
+	if(fd < 0)
+		return false;
+
+	if(fstat(fd, &st) != 0 || st.st_size == 0) {
+		close(fd);
+		return false;
+	}
+
+	void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+
+	if(data == MAP_FAILED)
+		return false;
+
+	const PreAnalysisHeader *header = (const PreAnalysisHeader*)data;
+
+	if((size_t)st.st_size < sizeof(PreAnalysisHeader)) {
+		errs() << "Warning: " << fileName << " is truncated, the initcalls are analyzed again!\n";
+		munmap(data, st.st_size);
+		return false;
+	}
+
+	if(memcmp(header->magic, PREANALYSIS_MAGIC, 4) != 0) {
+		munmap(data, st.st_size);
+
+		std::ifstream in(fileName.c_str(), std::ifstream::in);
+		errs() << "Warning: " << fileName << " has the former text format, it isn't checked against the kernel!\n";
+		return importTextPreAnalysisResults(in);
+	}
+
+	ValueIDMap *valueIDMap = ValueIDMap::getValueIDMap();
+	FileIdentity moduleFile;
+	uint8_t moduleHash[16];
+
+	if(!moduleFile.read(module->getModuleIdentifier())) {
+		errs() << "Warning: Could not read the bitcode file, the initcalls are analyzed again!\n";
+		munmap(data, st.st_size);
+		return false;
+	}
+
+	// The bitcode is only hashed if its file changed since the export.
+	bool sameFile = moduleFile == header->moduleFile;
+
+	if(header->version != PREANALYSIS_VERSION || header->numKernelIDs != valueIDMap->getNumFrozenIDs() ||
+	   (!sameFile && (!getModuleHash(moduleHash) || memcmp(header->moduleHash, moduleHash, 16) != 0))) {
+		errs() << "Warning: " << fileName << " belongs to another kernel or version, the initcalls are analyzed again!\n";
+		munmap(data, st.st_size);
+		return false;
+	}
+
+	const char *base = (const char*)data;
+	const uint32_t *end = (const uint32_t*)(base + st.st_size - st.st_size % sizeof(uint32_t));
+	WordReader reader((const uint32_t*)(header + 1), end);
+	const uint32_t *offsets = nullptr;
+	const uint32_t numKernelIDs = header->numKernelIDs;
+	std::vector<uint32_t> lateIDs;
+	// The offsets have to fit into the file, numStrings + 1 mustn't wrap around.
+	bool valid = header->numStrings < (st.st_size - sizeof(PreAnalysisHeader)) / sizeof(uint32_t)
+		&& reader.read((uint64_t)header->numStrings + 1, offsets);
+
+	// Only the names that aren't part of the kernel numbering are numbered here.
+	for(uint32_t i = 0; valid && i < header->numStrings; i++) {
+		valid = offsets[i] <= offsets[i + 1] && offsets[i + 1] <= st.st_size;
+
+		if(valid) {
+			std::string name(base + offsets[i], offsets[i + 1] - offsets[i]);
+			lateIDs.push_back(valueIDMap->getID(name));
+		}
+	}
+
+	// The strings are padded, so the records start at a word boundary.
+	if(valid) {
+		uint64_t recordOffset = ((uint64_t)offsets[header->numStrings] + 3) & ~(uint64_t)3;
+		valid = recordOffset <= st.st_size;
+		reader = WordReader((const uint32_t*)(base + recordOffset), end);
+	}
+
+	auto getID = [&](uint32_t word, uint32_t &id) {
+		if(word < numKernelIDs) {
+			id = word;
+			return true;
+		}
+
+		if(word - numKernelIDs >= lateIDs.size())
+			return false;
+
+		id = lateIDs[word - numKernelIDs];
+		return true;
+	};
+
+	auto readSet = [&](uint32_t num, IDSet &set) {
+		const uint32_t *words = nullptr;
+		uint32_t id;
+
+		if(!reader.read(num, words))
+			return false;
+
+		for(uint32_t i = 0; i < num; i++) {
+			if(!getID(words[i], id))
+				return false;
+			set.set(id);
+		}
+
+		return true;
+	};
+
+	for(uint32_t i = 0; valid && i < header->numInitcalls; i++) {
+		uint32_t name, level, depth, numFuncs, numGVs, numNonDefVars;
+		IDSet functions, globalvars, nondefvars;
+
+		valid = reader.read(name) && reader.read(level) && reader.read(depth) && reader.read(numFuncs) &&
+			reader.read(numGVs) && reader.read(numNonDefVars) && getID(name, name) &&
+			readSet(numFuncs, functions) && readSet(numGVs, globalvars) && readSet(numNonDefVars, nondefvars);
+
+		if(!valid)
+			break;
+
+		std::string initcallName = valueIDMap->getName(name);
+		initcalls[initcallName] = Initcall(initcallName, level, functions, globalvars, nondefvars, depth);
+	}
+
+	for(uint32_t i = 0; valid && i < header->numNonDefVars; i++) {
+		uint32_t name, numFuncs, numGVs;
+
+		valid = reader.read(name) && reader.read(numFuncs) && reader.read(numGVs) && getID(name, name) &&
+			readSet(numFuncs, nonDefVarFuncs[name]) && readSet(numGVs, nonDefVarGVs[name]);
+	}
+
+	if(valid) {
+		maxCGDepth = header->maxCGDepth;
+		maxNumInitcallFunctions = header->maxNumInitcallFunctions;
+		maxNumInitcallGlobalVars = header->maxNumInitcallGlobalVars;
+	} else {
+		errs() << "Warning: " << fileName << " is corrupted, the initcalls are analyzed again!\n";
+		initcalls.clear();
+		nonDefVarFuncs.clear();
+		nonDefVarGVs.clear();
+	}
+
+	munmap(data, st.st_size);
+
+	if(valid)
+		outs() << "Context of " << initcalls.size() << " initcalls imported\n";
+
+	// The same kernel at another path or touched, the next import doesn't hash it again.
+	if(valid && !sameFile)
+		exportPreAnalysisResults();
+
+	return valid && initcalls.size() > 0;
+}
+
+bool InitcallFactory::importTextPreAnalysisResults(std::ifstream &in) {
+	ValueIDMap *valueIDMap = ValueIDMap::getValueIDMap();
 	u32_t numInitcalls = 0;
 	u32_t numNonDefVars = 0;
 	u32_t numNonDefVarFuncs = 0;
@@ -450,21 +956,22 @@ bool InitcallFactory::importPreAnalysisResults() {
 			std::string nondefvar= "";
 			in >> nondefvar;
 			in >> numNonDefVarFuncs;
-			StringSet &funcSet = nonDefVarFuncs[nondefvar];
+			uint32_t nondefvarID = valueIDMap->getID(nondefvar);
+			IDSet &funcSet = nonDefVarFuncs[nondefvarID];
 
 			for(int j=0; j < numNonDefVarFuncs; ++j) {
 				std::string function = "";
 				in >> function;
-				funcSet.insert(function);
+				funcSet.set(valueIDMap->getID(function));
 			}
 
 			in >> numNonDefVarGVs;
-			StringSet &gvSet = nonDefVarGVs[nondefvar];
+			IDSet &gvSet = nonDefVarGVs[nondefvarID];
 
 			for(int j=0; j < numNonDefVarGVs; ++j) {
 				std::string globalvar = "";
 				in >> globalvar;
-				gvSet.insert(globalvar);
+				gvSet.set(valueIDMap->getID(globalvar));
 			}
 		}
 			
@@ -477,54 +984,98 @@ bool InitcallFactory::importPreAnalysisResults() {
 }
 
 bool InitcallFactory::exportPreAnalysisResults() {
+	ValueIDMap *valueIDMap = ValueIDMap::getValueIDMap();
 	std::string fileName = PreAnalysisResults;
-//	outs() << "Export Pre-Analysis Results " << fileName << " ...\n";
-	std::ofstream out(fileName.c_str(), std::ofstream::out);
+	PreAnalysisHeader header;
+	std::vector<uint32_t> records;
 
-	if(out) {
-		out << initcalls.size() << "\n";
+	memset(&header, 0, sizeof(header));
 
-		for(auto iter = initcalls.begin(); iter != initcalls.end(); ++iter) {
-			Initcall &initcall = iter->second;
-			out << initcall;
-		}
+	if(!header.moduleFile.read(module->getModuleIdentifier()) || !getModuleHash(header.moduleHash)) {
+		errs() << "Warning: Could not read the bitcode file, the initcall contexts aren't exported!\n";
+		return false;
+	}
 
-		out << maxCGDepth << "\n";
-		out << maxNumInitcallFunctions << "\n";
-		out << maxNumInitcallGlobalVars << "\n";
-		out << nonDefVarFuncs.size() << "\n";
+	header.numKernelIDs = valueIDMap->getNumFrozenIDs();
+	StringTable table(header.numKernelIDs);
 
-		assert(nonDefVarFuncs.size() == nonDefVarGVs.size() && "nonDefVar map differ");
+	for(const auto &iter : initcalls) {
+		const Initcall &initcall = iter.second;
+		const IDSet &functions = initcall.getFunctionIDs();
+		const IDSet &globalvars = initcall.getGlobalVarIDs();
+		const IDSet &nondefvars = initcall.getNonDefVarIDs();
+
+		records.push_back(table.getIndex(valueIDMap->getID(initcall.getName())));
+		records.push_back(initcall.getLevel());
+		records.push_back(initcall.getMaxCGDepth());
+		records.push_back(functions.count());
+		records.push_back(globalvars.count());
+		records.push_back(nondefvars.count());
+
+		table.add(functions, records);
+		table.add(globalvars, records);
+		table.add(nondefvars, records);
+	}
 
-		for(int i=0; i < nonDefVarFuncs.size(); i++) {
-			auto funcIter = nonDefVarFuncs.begin();
-			auto gvIter = nonDefVarGVs.begin();
-			advance(funcIter, i);
-			advance(gvIter, i);
+	assert(nonDefVarFuncs.size() == nonDefVarGVs.size() && "nonDefVar map differ");
 
-			std::string nondefvar = funcIter->first;
-			StringSet &funcSet = funcIter->second;
-			StringSet &gvSet = gvIter->second;
+	for(const auto &iter : nonDefVarFuncs) {
+		const IDSet &funcSet = iter.second;
+		const IDSet &gvSet = nonDefVarGVs[iter.first];
 
-			out << nondefvar << "\n";
-			out << funcSet.size() << "\n";
+		records.push_back(table.getIndex(iter.first));
+		records.push_back(funcSet.count());
+		records.push_back(gvSet.count());
 
-			for(auto iter2 = funcSet.begin(); iter2 != funcSet.end(); ++iter2) {
-				out << (*iter2) << "\n";	
-			}
-			
-			out << gvSet.size() << "\n";
+		table.add(funcSet, records);
+		table.add(gvSet, records);
+	}
 
-			for(auto iter2 = gvSet.begin(); iter2 != gvSet.end(); ++iter2) {
-				out << (*iter2) << "\n";	
-			}
-		}
+	const std::vector<std::string> &strings = table.getStrings();
+	std::vector<uint32_t> offsets;
+	uint32_t offset = sizeof(PreAnalysisHeader) + (strings.size() + 1) * sizeof(uint32_t);
+
+	for(const auto &iter : strings) {
+		offsets.push_back(offset);
+		offset += iter.size();
+	}
+
+	offsets.push_back(offset);
+
+	memcpy(header.magic, PREANALYSIS_MAGIC, 4);
+	header.version = PREANALYSIS_VERSION;
+	header.numStrings = strings.size();
+	header.numInitcalls = initcalls.size();
+	header.numNonDefVars = nonDefVarFuncs.size();
+	header.maxCGDepth = maxCGDepth;
+	header.maxNumInitcallFunctions = maxNumInitcallFunctions;
+	header.maxNumInitcallGlobalVars = maxNumInitcallGlobalVars;
+
+	// Written to a temporary file first, so a crash doesn't leave a truncated cache behind.
+	std::string tmpFileName = fileName + ".tmp";
+	std::ofstream out(tmpFileName.c_str(), std::ofstream::out | std::ofstream::binary);
 
-		out.close();
-	} else
+	if(!out)
 		return false;
 
-//	outs() << "\t" << initcalls.size() << " initcalls exported\n";
+	out.write((const char*)&header, sizeof(header));
+	out.write((const char*)offsets.data(), offsets.size() * sizeof(uint32_t));
+
+	for(const auto &iter : strings)
+		out.write(iter.data(), iter.size());
+
+	// The records start at a word boundary.
+	for(uint32_t i = offset; i % 4 != 0; i++)
+		out.put('\0');
+
+	out.write((const char*)records.data(), records.size() * sizeof(uint32_t));
+	out.close();
+
+	if(!out || rename(tmpFileName.c_str(), fileName.c_str()) != 0) {
+		errs() << "Warning: Could not write the initcall contexts " << fileName << "!\n";
+		unlink(tmpFileName.c_str());
+		return false;
+	}
 
 	return true;
 }
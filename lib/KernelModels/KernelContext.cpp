@@ -28,27 +28,31 @@ IntToStrSet KernelContext::getInitcallLevelMap() {
 }
 
 void KernelContext::setAPI(KernelContextObj *api) {
+	ValueIDMap *valueIDMap = ValueIDMap::getValueIDMap();
+
 	this->api = api;
-}
+	apiRoots.clear();
 
-KernelContextObj* KernelContext::getAPI() {
-	return api;
-}
+	for(const auto &iter : api->getContextRoot())
+		apiRoots.insert(valueIDMap->getID(iter));
 
-void KernelContext::setNonDefVarFuncs(const StrToStrSet &nonDefVarFuncs) {
-	this->nonDefVarFuncs = nonDefVarFuncs;
-}
+	Systemcall *syscall = dyn_cast<Systemcall>(api);
+
+	if(syscall && syscall->getAlias() != "")
+		apiRoots.insert(valueIDMap->getID(syscall->getAlias()));
 
-StrToStrSet& KernelContext::getNonDefVarFuncs() {
-	return nonDefVarFuncs;
+	updateAPILookup();
 }
 
-void KernelContext::setNonDefVarGVs(const StrToStrSet &nonDefVarGVs) {
-	this->nonDefVarGVs = nonDefVarGVs;
+void KernelContext::updateAPILookup() {
+	const IDSet &functions = api->getFunctionIDs();
+
+	apiFunctions.clear();
+	apiFunctions.insert(functions.begin(), functions.end());
 }
 
-const StrToStrSet& KernelContext::getNonDefVarGVs() {
-	return nonDefVarGVs;
+KernelContextObj* KernelContext::getAPI() {
+	return api;
 }
 
 bool KernelContext::isInitcall(const llvm::Function *F) const {
@@ -59,20 +63,21 @@ bool KernelContext::isInitcall(const llvm::Function *F) const {
 }
 	
 StringSet KernelContext::getAllFunctions() const {
-	StringSet functions = getAllInitcallFuncs();
-	StringSet &apiFunctions = api->getFunctions();
+	IDSet functions = api->getFunctionIDs();
 
-	functions.insert(apiFunctions.begin(), apiFunctions.end());	
+	for(const auto &iter : initcalls)
+		functions |= iter.second.getFunctionIDs();
 
-	return functions;
+	return ValueIDMap::getValueIDMap()->getNames(functions);
 }
 
 StringSet KernelContext::getAllGlobalVars() const {
-	StringSet globalvars = getAllInitcallGlobalVars();
-	StringSet &apiGVs = api->getGlobalVars();
-	globalvars.insert(apiGVs.begin(), apiGVs.end());	
+	IDSet globalvars = api->getGlobalVarIDs();
 
-	return globalvars;
+	for(const auto &iter : initcalls)
+		globalvars |= iter.second.getGlobalVarIDs();
+
+	return ValueIDMap::getValueIDMap()->getNames(globalvars);
 }
 
 StringSet KernelContext::getAllInitcallNames() const {
@@ -86,36 +91,36 @@ StringSet KernelContext::getAllInitcallNames() const {
 }
 
 StringSet KernelContext::getAllInitcallFuncs() const {
-	StringSet functions;
+	IDSet functions;
 
 	for(const auto &iter : initcalls) {
 		const Initcall &initcall = iter.second;
-		functions.insert(initcall.getFunctions().begin(), initcall.getFunctions().end());
+		functions |= initcall.getFunctionIDs();
 	}	
 
-	return functions;
+	return ValueIDMap::getValueIDMap()->getNames(functions);
 }
 
 StringSet KernelContext::getAllInitcallGlobalVars() const {
-	StringSet globalvars;
+	IDSet globalvars;
 
 	for(const auto &iter : initcalls) {
 		const Initcall &initcall = iter.second;
-		globalvars.insert(initcall.getGlobalVars().begin(), initcall.getGlobalVars().end());
+		globalvars |= initcall.getGlobalVarIDs();
 	}	
 
-	return globalvars;
+	return ValueIDMap::getValueIDMap()->getNames(globalvars);
 }
 
 StringSet KernelContext::getAllInitcallNonDefVars() const {
-	StringSet nondefvars;
+	IDSet nondefvars;
 
 	for(const auto &iter : initcalls) {
 		const Initcall &initcall = iter.second;
-		nondefvars.insert(initcall.getNonDefVars().begin(), initcall.getNonDefVars().end());
+		nondefvars |= initcall.getNonDefVarIDs();
 	}	
 
-	return nondefvars;
+	return ValueIDMap::getValueIDMap()->getNames(nondefvars);
 }
 
 uint32_t KernelContext::getInitcallsMaxCGDepth() const {
@@ -133,44 +138,6 @@ uint32_t KernelContext::getInitcallsMaxCGDepth() const {
 	return maxDepth;
 }
 
-StringSet KernelContext::getNonDefVarFunctions(const Initcall &initcall, const StringSet &nonDefVars) const {
-	const StringSet &initcallFuncs = initcall.getFunctions();
-	StringSet relevantNonDefVarFuncs;
-
-	for(auto iter = nonDefVars.begin(); iter != nonDefVars.end(); ++iter) {
-		const StringSet &funcs = nonDefVarFuncs.at(*iter);
-		StringSet interSet;
-
-		set_intersection(initcallFuncs.cbegin(), initcallFuncs.cend(), 
-				 funcs.begin(), funcs.end(), 
-				 std::inserter(interSet, interSet.begin()));
-
-		relevantNonDefVarFuncs.insert(interSet.begin(), interSet.end());
-	}
-
-	relevantNonDefVarFuncs.insert(initcall.getName());
-
-	return relevantNonDefVarFuncs;
-}
-
-StringSet KernelContext::getNonDefVarGlobalVars(const Initcall &initcall, const StringSet &nonDefVars) const {
-	const StringSet &initcallGVs = initcall.getGlobalVars();
-	StringSet relevantNonDefVarGVs;
-
-	for(auto iter = nonDefVars.begin(); iter != nonDefVars.end(); ++iter) {
-		const StringSet &globalvars = nonDefVarGVs.at(*iter);
-		StringSet interSet;
-
-		set_intersection(initcallGVs.cbegin(), initcallGVs.cend(), 
-				 globalvars.begin(), globalvars.end(), 
-				 std::inserter(interSet, interSet.begin()));
-
-		relevantNonDefVarGVs.insert(interSet.begin(), interSet.end());
-	}
-
-	return relevantNonDefVarGVs;
-}
-
 uint32_t KernelContext::getKernelOrigNumFuncs() {
 	return kernelOrigNumFunctions;
 }
@@ -2,24 +2,39 @@
 #include "KernelModels/SyscallBuilder.h"
 #include "KernelModels/DriverBuilder.h"
 #include "KernelModels/Systemcall.h"
+#include "Util/SyscallAPI.h"
+#include "Util/ValueIDMap.h"
 
 static cl::opt<std::string> SYSCALL("syscall", cl::init(""),
 		cl::desc("The analysis will start with this function."));
 static cl::opt<std::string> DRIVER("driver", cl::init(""),
 		cl::desc("The analysis will start with the API-functions of this driver."));
+static cl::opt<bool> ALLSYSCALLS("all-syscalls", cl::init(false),
+		cl::desc("Analyze all known system calls one after another."));
+static cl::opt<std::string> SYSCALLLIST("syscall-list", cl::init(""),
+		cl::desc("Analyze all system calls listed in this file (one per line)."));
 
 using namespace llvm;
 using namespace analysisUtil;
 
 void KernelContextFactory::initialize() {
+	// Number the kernel up front, the parallel analyses only look its IDs up.
+	ValueIDMap *valueIDMap = ValueIDMap::createValueIDMap();
+	valueIDMap->addModule(module);
+	valueIDMap->freeze();
+
 	initKernelContext();
 
-	if(SYSCALL != "" && DRIVER == "") {
-		apiBuilder = new SyscallBuilder(module);
-		rawAPIList.push_back(SYSCALL);
+	if(ALLSYSCALLS || SYSCALLLIST != "") {
+		selectAPI("", KernelContextObj::SYSCALL);
+		collectSyscalls();
+	} else if(SYSCALL != "" && DRIVER == "") {
+		selectAPI(SYSCALL, KernelContextObj::SYSCALL);
 	} else if (SYSCALL == "" && DRIVER != "") {
-		apiBuilder = new DriverBuilder(module);
-		rawAPIList.push_back(DRIVER);
+		selectAPI(DRIVER, KernelContextObj::DRIVER);
+	} else if(resident) {
+		// Most requests are system calls, so its call graph is built in advance.
+		selectAPI("", KernelContextObj::SYSCALL);
 	} else {
 		errs() << "Warning: A system call or driver has to be selected!\n";
 		return;
@@ -28,9 +43,7 @@ void KernelContextFactory::initialize() {
 	// The creation of the initcall contexts only has to be done once.
 	initcallFactory = InitcallFactory::createInitcallFactory(module);
 	kernelCxt->setInitcalls(initcallFactory->getInitcalls());
-	//TODO integrate both into initcall.h
-	kernelCxt->setNonDefVarFuncs(initcallFactory->getNonDefVarFuncs());
-	kernelCxt->setNonDefVarGVs(initcallFactory->getNonDefVarGVs());
+	kernelCxt->setNonDefVarIndex(initcallFactory->getNonDefVarIndex());
 }
 
 
@@ -40,9 +53,16 @@ bool KernelContextFactory::updateContext() {
 	if(cxtRootName == "")
 		return false;
 
+	// The partitioner filters the initcalls of the previous context.
+	kernelCxt->setInitcalls(initcallFactory->getInitcalls());
+
 	apiBuilder->build(cxtRootName);
 	kernelCxt->setAPI(apiBuilder->getContext());
 
+	// The partitioner merges the initcalls into the context, a lazily loaded kernel needs their bodies.
+	materializeFunctions(module, initcallFactory->getAllInitcallFuncs(initcallFactory->getInitcalls()), false);
+	materializeFunctions(module, initcallFactory->getAllNonDefVarFuncs(), false);
+
 	// Set statistis of the context 
 	cxtStat.setCxtName(kernelCxt->getAPI()->getName());
 	cxtStat.setCxtType(kernelCxt->getAPI()->getContextTypeName());
@@ -72,14 +92,63 @@ void KernelContextFactory::initKernelContext() {
 	kernelCxt = KernelContext::createKernelContext();
 }
 
+void KernelContextFactory::selectAPI(const std::string &cxtRoot, KernelContextObj::CONTEXT_TYPE type) {
+	if(apiBuilder == nullptr || apiType != type) {
+		if(apiBuilder != nullptr)
+			delete apiBuilder;
+
+		if(type == KernelContextObj::DRIVER)
+			apiBuilder = new DriverBuilder(module);
+		else
+			apiBuilder = new SyscallBuilder(module);
+
+		apiType = type;
+	}
+
+	rawAPIList.clear();
+
+	if(cxtRoot != "")
+		rawAPIList.push_back(cxtRoot);
+}
+
 std::string KernelContextFactory::getNextCxtRoot() {
 	std::string funcName;
 
 	if(rawAPIList.empty())
 		return "";
        
-	funcName = rawAPIList.back();
-	rawAPIList.pop_back();
+	funcName = rawAPIList.front();
+	rawAPIList.pop_front();
 
 	return funcName;
 }
+
+void KernelContextFactory::collectSyscalls() {
+	SyscallAPI *syscallAPI = SyscallAPI::createSyscallAPI();
+	SyscallAPI::StringSetList syscallList;
+	StringSet knownSyscalls;
+
+	if(SYSCALLLIST != "")
+		syscallList = syscallAPI->getRelatedSyscallNamesByFile(SYSCALLLIST);
+	else
+		syscallList = syscallAPI->getAllSyscallNames();
+
+	for(const auto &iter : syscallList) {
+		for(const auto &syscallName : iter) {
+			if(syscallName == "" || !knownSyscalls.insert(syscallName).second)
+				continue;
+
+			// Not every system call is compiled into the given kernel.
+			if(module.getFunction(syscallName) == nullptr) {
+				errs() << "Warning: System call " << syscallName << " not found in module!\n";
+				continue;
+			}
+
+			rawAPIList.push_back(syscallName);
+		}
+	}
+
+	outs() << "Number of system calls to analyze: " << rawAPIList.size() << "\n";
+
+	SyscallAPI::releaseSyscallAPI();
+}
@@ -1,5 +1,6 @@
 #include "KernelModels/KernelExtPass.h"
 #include "Util/DebugUtil.h"
+#include "Util/NameMatcher.h"
 #include "llvm/Support/raw_ostream.h"
 
 using namespace llvm;
@@ -10,41 +11,28 @@ static RegisterPass<KernelExtPass> KERNELALLOCTRANSFORMPASS("kernel-alloc-transf
 								"KernelExtPass");
 
 bool KernelExtPass::transform() {
-	StringSet workset;
-	StringSet kernelAllocFunctions = extAPI->get_functions(ExtAPI::EFT_KALLOC);
-	StringSet kernelFreeFunctions = extAPI->get_functions(ExtAPI::EFT_KFREE);
-	StringSet kernelLockFunctions = extAPI->get_functions(ExtAPI::EFT_KLOCK);
-	StringSet kernelUnlockFunctions = extAPI->get_functions(ExtAPI::EFT_KUNLOCK);
-//	StringSet kernelDelFunctions = extAPI->get_functions(ExtAPI::EFT_KDEL);
+	NameMatcher matcher;
 
-	workset.insert(kernelAllocFunctions.begin(), kernelAllocFunctions.end());
-	workset.insert(kernelFreeFunctions.begin(), kernelFreeFunctions.end());
-	workset.insert(kernelLockFunctions.begin(), kernelLockFunctions.end());
-	workset.insert(kernelUnlockFunctions.begin(), kernelUnlockFunctions.end());
+	matcher.addPatterns(extAPI->get_functions(ExtAPI::EFT_KALLOC), KALLOC);
+	matcher.addPatterns(extAPI->get_functions(ExtAPI::EFT_KFREE), KFREE);
+	matcher.addPatterns(extAPI->get_functions(ExtAPI::EFT_KLOCK), KLOCK);
+	matcher.addPatterns(extAPI->get_functions(ExtAPI::EFT_KUNLOCK), KUNLOCK);
+//	matcher.addPatterns(extAPI->get_functions(ExtAPI::EFT_KDEL), KDEL);
 
 	std::set<llvm::Function*> irrelevantFunctions;
 
-	for(auto iter = workset.begin(); iter != workset.end(); ++iter) {
-		std::string funcSubName = *iter; 
+	// The functions are classified first, replacing them changes the module.
+	for(auto iter = module->begin(); iter != module->end(); ++iter) {
+		llvm::Function *F = &*iter;
 
-		for(auto iter2 = module->begin(); iter2 != module->end(); ++iter2) {
-			llvm::Function *F = &*iter2;
-
-			if(F == nullptr)
-				continue;
-
-			std::string funcName = F->getName();
-
-			if(funcName.find(funcSubName) != std::string::npos) {
-				irrelevantFunctions.insert(F);
-			}
-		}
+		if(matcher.matches(F))
+			irrelevantFunctions.insert(F);
 	}
 
 	for(auto iter = irrelevantFunctions.begin(); iter != irrelevantFunctions.end(); ++iter)
 		replaceFuncDefByDec(*iter);
 
-	return !workset.empty();
+	return !irrelevantFunctions.empty();
 }
 
 void KernelExtPass::replaceFuncDefByDec(llvm::Function *F) {
@@ -1,6 +1,7 @@
 #include "KernelModels/KernelPartitioner.h"
 #include "Util/InstrumentationUtil.h"
 #include "Util/CallGraphAnalysis.h"
+#include "Util/DebugInfoIndex.h"
 #include "SVF/MemoryModel/PAGBuilder.h"
 
 using namespace llvm;
@@ -17,14 +18,20 @@ void KernelPartitioner::initialize(llvm::Module &module) {
 	this->module = &module;
 	KernelContextObj *api = kernelCxt->getAPI();
 
+	// The checkers might work on a copy of the kernel, its values are mapped to their IDs as well.
+	ValueIDMap::getValueIDMap()->addModule(module);
+
+	// The checkers look up the debug info of its values in parallel.
+	DebugInfoIndex::getDebugInfoIndex()->addModule(module);
+
 	// Collect the statistical infos before the final partitioning.
 	partStat.setNumIO(kernelCxt->getAllInitcallNames().size());
 	partStat.setNumIOFuncs(kernelCxt->getAllInitcallFuncs().size());
 	partStat.setNumIOGVs(kernelCxt->getAllInitcallGlobalVars().size());
 	partStat.setNumIONDGVs(kernelCxt->getAllInitcallNonDefVars().size());
 	partStat.setIOCGDepth(0);
-	partStat.setNumAOFuncs(api->getFunctions().size());
-	partStat.setNumAOGVs(api->getGlobalVars().size());
+	partStat.setNumAOFuncs(api->getNumFunctions());
+	partStat.setNumAOGVs(api->getNumGlobalVars());
 	partStat.setAOCGDepth(0);
 	partStat.setNumKOFuncs(module.getFunctionList().size());
 	partStat.setNumKOGVs(module.getGlobalList().size());
@@ -39,6 +46,9 @@ void KernelPartitioner::finalize() {
 	const auto &globalvars = module->getGlobalList();
 	KernelContextObj *api = kernelCxt->getAPI();
 
+	// The checkers query the final functions of the API in parallel.
+	kernelCxt->updateAPILookup();
+
 	StringSet nondefvars;
 
 	for(const auto &iter : globalvars) {
@@ -54,9 +64,9 @@ void KernelPartitioner::finalize() {
 	partStat.setNumIRGVs(kernelCxt->getAllInitcallGlobalVars().size());
 	partStat.setNumIRNDGVs(kernelCxt->getAllInitcallNonDefVars().size());
 	partStat.setIRCGDepth(0);
-	partStat.setNumARFuncs(api->getFunctions().size());
-	partStat.setNumARGVs(api->getGlobalVars().size());
-	partStat.setARCGDepth(0);
+	partStat.setNumARFuncs(api->getNumFunctions());
+	partStat.setNumARGVs(api->getNumGlobalVars());
+	partStat.setARCGDepth(api->getMaxCGDepth());
 	partStat.setNumKRFuncs(module->getFunctionList().size());
 	partStat.setNumKRGVs(module->getGlobalList().size());
 	partStat.setFuncLimit(FUNCTIONLIMIT);
@@ -114,11 +124,23 @@ void KernelPartitioner::dumpPAGStat(llvm::Module &module) {
 }
 
 void KernelPartitioner::mergeContexts() {
+	StringSet relevantFuncs;
+	StringSet relevantGVs;
+
+	getRelevantValues(relevantFuncs, relevantGVs);
+
+	if(incremental)
+		incremental->recordDependencies(*module, relevantFuncs, relevantGVs);
+
+	analysisUtil::minimizeModule(*module, relevantFuncs, relevantGVs);
+}
+
+void KernelPartitioner::getRelevantValues(StringSet &relevantFuncs, StringSet &relevantGVs) {
 	InitcallMap &initcalls = kernelCxt->getInitcalls();
 	KernelContextObj *api = kernelCxt->getAPI();
-	StringSet totalFunctions = api->getFunctions();
-	StringSet totalGlobalVars = api->getGlobalVars();
-	StringSet totalNonDefVars;
+	ValueIDMap *valueIDMap = ValueIDMap::getValueIDMap();
+	IDSet totalFunctions = api->getFunctionIDs();
+	IDSet totalGlobalVars = api->getGlobalVarIDs();
 
 	// Removes the initcalls that are not relevant for the analysis.(doesn't change the module!)
 	filterRelevantInitcalls(initcalls, api);
@@ -127,48 +149,61 @@ void KernelPartitioner::mergeContexts() {
 	for(const auto &iter : initcalls) {
 		const Initcall &initcall = iter.second;
 
-		totalFunctions.insert(initcall.getFunctions().begin(), initcall.getFunctions().end());
-		totalGlobalVars.insert(initcall.getGlobalVars().begin(), initcall.getGlobalVars().end());
-		totalNonDefVars.insert(initcall.getNonDefVars().begin(), initcall.getNonDefVars().end());
+		totalFunctions |= initcall.getFunctionIDs();
+		totalGlobalVars |= initcall.getGlobalVarIDs();
 	}	
 
 	// Is needed to get filenames and line numbers etc.
 	if(!totalFunctions.empty())
-		totalFunctions.insert("llvm.dbg.declare");
+		totalFunctions.set(valueIDMap->getID("llvm.dbg.declare"));
 
-	analysisUtil::minimizeModule(*module, totalFunctions, totalGlobalVars);
+	relevantFuncs = valueIDMap->getNames(totalFunctions);
+	relevantGVs = valueIDMap->getNames(totalGlobalVars);
 }
 
 void KernelPartitioner::filterRelevantInitcalls(InitcallMap &initcalls, const KernelContextObj *api) {
-	const StringSet apiGlobalVars = api->getGlobalVars(); 
+	const NonDefVarIndex &nonDefVarIndex = kernelCxt->getNonDefVarIndex();
+	ValueIDMap *valueIDMap = ValueIDMap::getValueIDMap();
+	StrToIDSet interSets;
+	StrToIDSet relevantFuncs;
+	StrToIDSet relevantGVs;
+
+	// Find the non defined global variables used by the systemcall and their initcalls. 
+	for(const auto &globalvar : api->getGlobalVarIDs()) {
+		auto indexIter = nonDefVarIndex.find(globalvar);
+
+		if(indexIter == nonDefVarIndex.end())
+			continue;
+
+		for(const auto &use : indexIter->second) {
+			interSets[use.initcall].set(globalvar);
+			// Functions that might used by the initcall to define the non defined variables.
+			relevantFuncs[use.initcall] |= use.functions;
+			// Global variables that might used by the initcall to define the non defined variables.
+			relevantGVs[use.initcall] |= use.globalvars;
+		}
+	}
 
 	for(auto iter = initcalls.begin(); iter != initcalls.end();) {
 		std::string initcallName = iter->first; 
 		Initcall &initcall = iter->second;
-		StringSet interSet;
-		const StringSet &initcallFuncs = initcall.getFunctions();
-		const StringSet &initcallGlobalVars = initcall.getGlobalVars();
-		const StringSet &initcallNonDefVars = initcall.getNonDefVars();
+		auto interIter = interSets.find(initcallName);
 
-		// Find the non defined global variables used by the systemcall. 
-		set_intersection(apiGlobalVars.cbegin(), apiGlobalVars.cend(), 
-				 initcallNonDefVars.begin(), initcallNonDefVars.end(), 
-				 std::inserter(interSet, interSet.begin()));
-
-		if(interSet.size() == 0) {
+		if(interIter == interSets.end()) {
 			iter = initcalls.erase(iter); 
 		} else {
-			// Functions that might used by the initcall to define the non defined variables.
-			StringSet relevantFuncs = kernelCxt->getNonDefVarFunctions(initcall, interSet);
-			// Global variables that might used by the initcall to define the non defined variables.
-			StringSet relevantGVs = kernelCxt->getNonDefVarGlobalVars(initcall, interSet);
+			const IDSet &interSet = interIter->second;
+			IDSet &funcs = relevantFuncs[initcallName];
+			IDSet &globalvars = relevantGVs[initcallName];
+
+			funcs.set(valueIDMap->getID(initcallName));
 			// The nondefined variables as well.
-			relevantGVs.insert(interSet.begin(), interSet.end());
+			globalvars |= interSet;
 
-			initcall.setFunctions(relevantFuncs);
+			initcall.setFunctions(funcs);
 			// Info:: globalvars can potentially contain nondefvars that are not in nondefvars.
 			// 	  thats because they are not relevant for the systemcall but for the nondefvars.
-			initcall.setGlobalVars(relevantGVs);
+			initcall.setGlobalVars(globalvars);
 			initcall.setNonDefVars(interSet);
 			iter++;
 		}
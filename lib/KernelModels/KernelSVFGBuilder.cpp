@@ -52,6 +52,8 @@ void KernelSVFGBuilder::createSVFG(MemSSA* mssa, SVFG* graph) {
 
 	DBOUT(DGENERAL, outs() << pasMsg("\tAdd Sink SVFG Nodes\n"));
 
+	KernelCheckerAPI::getCheckerAPI()->addModule(*pta->getModule());
+
 	AddExtActualParmSVFGNodes();
 
 	collectAllocationNodes();
@@ -19,7 +19,13 @@ void SyscallBuilder::build(std::string cxtRootName) {
 }
 
 void SyscallBuilder::optimizeContext() {
-	std::unique_ptr<llvm::Module> optModule = CloneModule(&module);
+	// Only copy the part of the kernel that belongs to the context.
+	std::unique_ptr<llvm::Module> optModule = analysisUtil::extractModule(module, context->getFunctions(), 
+			context->getGlobalVars());
+
+	// The call-graph analyses of the reductions look its values up by their IDs.
+	ValueIDMap::getValueIDMap()->addModule(*optModule.get());
+
 	anderOpt(*optModule.get(), context);
 	flowOpt(*optModule.get(), context);
 	minimizeContext(*optModule.get(), context);
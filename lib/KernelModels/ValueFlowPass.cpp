@@ -0,0 +1,43 @@
+#include "KernelModels/ValueFlowPass.h"
+#include <omp.h>
+
+using namespace llvm;
+
+char ValueFlowPass::ID = 0;
+
+static RegisterPass<ValueFlowPass> VALUEFLOWPASS("value-flow", "ValueFlowPass", false, true);
+
+bool ValueFlowPass::runOnModule(llvm::Module& module) {
+	outs() << "\n\n" << getPassName() << ":\n";
+	outs() << "====================================================\n";
+
+	double start_t = omp_get_wtime();
+
+	// Creates PAG, MemSSA, PTACallGraph, SVFG
+	ander = AndersenWaveDiff::createAndersenWaveDiff(module);
+	svfg = new SVFGOPT(ander->getPTACallGraph());
+	svfgBuilder = new KernelSVFGBuilder();
+	svfgBuilder->build(svfg, ander);
+
+	outs() << "Num SVFG Nodes: " << svfg->getTotalNodeNum() << "\n";
+	outs() << "Time (sec): " << (int)(omp_get_wtime() - start_t) << "\n";
+
+	return false;
+}
+
+void ValueFlowPass::releaseMemory() {
+	if(svfg != nullptr)
+		delete svfg;
+	svfg = nullptr;
+
+	if(svfgBuilder != nullptr)
+		delete svfgBuilder;
+	svfgBuilder = nullptr;
+
+	// The andersen analysis doesn't release the PAG.
+	if(ander != nullptr) {
+		AndersenWaveDiff::releaseAndersenWaveDiff();
+		PAG::releasePAG();
+	}
+	ander = nullptr;
+}
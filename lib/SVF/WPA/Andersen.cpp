@@ -54,6 +54,8 @@ double Andersen::timeOfProcessCopyGep = 0;
 double Andersen::timeOfProcessLoadStore = 0;
 double Andersen::timeOfUpdateCallGraph = 0;
 
+Andersen::ResultCache* Andersen::resultCache = NULL;
+
 
 /*!
  * We start from here
@@ -431,6 +433,68 @@ bool Andersen::updateCallGraph(const CallSiteToFunPtrMap& callsites) {
     return false;
 }
 
+/*!
+ * Restore the points-to set of a node
+ */
+void Andersen::addCachedPts(NodeID id, const PointsTo& pts) {
+    unionPts(id, pts);
+}
+
+/*!
+ * Restore an indirect call edge and connect its parameters in the constraint graph
+ */
+void Andersen::addCachedIndCall(llvm::CallSite cs, const llvm::Function* callee) {
+    if (getIndCallMap()[cs].count(callee))
+        return;
+
+    getIndCallMap()[cs].insert(callee);
+    getPTACallGraph()->addIndirectCallGraphEdge(cs.getInstruction(), callee);
+
+    NodePairSet cpySrcNodes;
+    consCG->connectCaller2CalleeParams(cs, callee, cpySrcNodes);
+}
+
+/*!
+ * Rebuild the constraint graph of a cached run
+ */
+void Andersen::restoreCachedConstraints() {
+    /// Adding copy edges changes the edge sets of the nodes, so the loads and stores are collected first
+    std::vector<const ConstraintEdge*> loads;
+    std::vector<const ConstraintEdge*> stores;
+    for (ConstraintGraph::const_iterator nodeIt = consCG->begin(), nodeEit = consCG->end(); nodeIt != nodeEit; nodeIt++) {
+        ConstraintNode* node = nodeIt->second;
+        loads.insert(loads.end(), node->outgoingLoadsBegin(), node->outgoingLoadsEnd());
+        stores.insert(stores.end(), node->incomingStoresBegin(), node->incomingStoresEnd());
+    }
+
+    /// The points-to sets are final, so every copy edge of solving is added at once
+    for (std::vector<const ConstraintEdge*>::iterator it = loads.begin(), eit = loads.end(); it != eit; ++it) {
+        PointsTo pts = getPts((*it)->getSrcID());
+        for (PointsTo::iterator piter = pts.begin(), epiter = pts.end(); piter != epiter; ++piter)
+            processLoad(*piter, *it);
+    }
+    for (std::vector<const ConstraintEdge*>::iterator it = stores.begin(), eit = stores.end(); it != eit; ++it) {
+        PointsTo pts = getPts((*it)->getDstID());
+        for (PointsTo::iterator piter = pts.begin(), epiter = pts.end(); piter != epiter; ++piter)
+            processStore(*piter, *it);
+    }
+
+    /// Merge the cycles, gep edges within a cycle make its objects field-insensitive
+    SCCDetect();
+
+    NodeBS pwcNodes;
+    for (ConstraintGraph::const_iterator nodeIt = consCG->begin(), nodeEit = consCG->end(); nodeIt != nodeEit; nodeIt++) {
+        if (nodeIt->second->isPWCNode())
+            pwcNodes.set(nodeIt->first);
+    }
+    for (NodeBS::iterator it = pwcNodes.begin(), eit = pwcNodes.end(); it != eit; ++it) {
+        if (sccRepNode(*it) == *it)
+            collapseNodePts(*it);
+    }
+    while (consCG->hasNodesToBeCollapsed())
+        collapseField(consCG->getNextCollapseNode());
+}
+
 /*
  * Merge a node to its rep node
  */
@@ -6,7 +6,7 @@ using namespace llvm;
 using namespace analysisUtil;
 using namespace svfgAnalysisUtil;
 
-bool AnalysisContext::isReachable(const NodeIDPair &edge1, const NodeIDPair &edge2, bool dominates) {
+bool AnalysisContext::isReachable(const NodeIDPair &edge1, const NodeIDPair &edge2, bool dominates) const {
 	const SVFGNode *parentNode1 = getSVFG()->getSVFGNode(edge1.second);
 	const SVFGNode *parentNode2 = getSVFG()->getSVFGNode(edge2.second);
 	const SVFGNode *childNode1 = getSVFG()->getSVFGNode(edge1.first);
@@ -18,15 +18,15 @@ bool AnalysisContext::isReachable(const NodeIDPair &edge1, const NodeIDPair &edg
 	const llvm::Function *callerFunc;
 
 	//TODO RM
-	if(getSVFGFuncName(parentNode1) != getSVFGFuncName(parentNode2)) {
+	if(getSVFGFunction(parentNode1) != getSVFGFunction(parentNode2)) {
 		return false;
 	}
-	assert(getSVFGFuncName(parentNode1) == getSVFGFuncName(parentNode2) && "Different parent nodes");
+	assert(getSVFGFunction(parentNode1) == getSVFGFunction(parentNode2) && "Different parent nodes");
 	
 	if(!BB1 || !BB2) 
 		return false;
 
-	if(getSVFGFuncName(childNode1) != getSVFGFuncName(childNode2)) {
+	if(getSVFGFunction(childNode1) != getSVFGFunction(childNode2)) {
 		inst1 = getInstruction(parentNode1, childNode1);
 		inst2 = getInstruction(parentNode2, childNode2);
 	 	callerFunc = parentNode1->getBB()->getParent();
@@ -70,7 +70,7 @@ bool AnalysisContext::isReachable(const NodeIDPair &edge1, const NodeIDPair &edg
 	return dt->dominates(inst1, inst2);
 }
 
-bool AnalysisContext::isReachable(const KSrcSnkDPItem &item1, const KSrcSnkDPItem &item2, bool dominates) {
+bool AnalysisContext::isReachable(const KSrcSnkDPItem &item1, const KSrcSnkDPItem &item2, bool dominates) const {
 	const VFPathCond::EdgeSet &curPath = item1.getCond().getVFEdges();
 	const VFPathCond::EdgeSet &curSortedPath = item2.getCond().getVFEdges();
 
@@ -80,7 +80,9 @@ bool AnalysisContext::isReachable(const KSrcSnkDPItem &item1, const KSrcSnkDPIte
 	int j2=curSortedPath.size()-1;
 	int lastCommonNodeIndex1 = j1;
 	int lastCommonNodeIndex2 = j2;
-	std::string commonFunction = "";
+	// The common function is unset until the paths share one.
+	const llvm::Function *commonFunction = nullptr;
+	bool hasCommonFunction = false;
 
 	while(!foundEdge1 || !foundEdge2) {
 		const NodeIDPair &edge1 = curPath[j1];
@@ -89,37 +91,42 @@ bool AnalysisContext::isReachable(const KSrcSnkDPItem &item1, const KSrcSnkDPIte
 		const SVFGNode *parentNode2 = getSVFG()->getSVFGNode(edge2.second);
 		const SVFGNode *childNode1 = getSVFG()->getSVFGNode(edge1.first);
 		const SVFGNode *childNode2 = getSVFG()->getSVFGNode(edge2.first);
-		std::string prevFunction1 = getSVFGFuncName(parentNode1);
-		std::string prevFunction2 = getSVFGFuncName(parentNode2);
-		std::string curFunction1 = getSVFGFuncName(childNode1);
-		std::string curFunction2 = getSVFGFuncName(childNode2);
+		const llvm::Function *prevFunction1 = getSVFGFunction(parentNode1);
+		const llvm::Function *prevFunction2 = getSVFGFunction(parentNode2);
+		const llvm::Function *curFunction1 = getSVFGFunction(childNode1);
+		const llvm::Function *curFunction2 = getSVFGFunction(childNode2);
+		auto isCommonFunction = [&](const llvm::Function *F) { 
+			return hasCommonFunction && commonFunction == F; 
+		};
 
 		if(j1 > 0 && j2 > 0 && edge1.first == edge2.first) {
 			commonFunction = curFunction1;
+			hasCommonFunction = true;
 			j1--; j2--;
 			continue;
 		} else if(j1 > 0 && j2 > 0 && !foundEdge1 && !foundEdge2 && curFunction1 == curFunction2) {
 			commonFunction = curFunction1;
+			hasCommonFunction = true;
 			j1--; j2--;
 			continue;
-		} else if(commonFunction == prevFunction1 && isRet(edge1.second, edge1.first)) {
+		} else if(isCommonFunction(prevFunction1) && isRet(edge1.second, edge1.first)) {
 			return false;
-		} else if(commonFunction == prevFunction2 && isRet(edge2.second, edge2.first)) {
+		} else if(isCommonFunction(prevFunction2) && isRet(edge2.second, edge2.first)) {
 			return false;
 		} 
 
-		if(commonFunction == prevFunction1 && !foundEdge1 && isCall(edge1.second, edge1.first))
+		if(isCommonFunction(prevFunction1) && !foundEdge1 && isCall(edge1.second, edge1.first))
 			lastCommonNodeIndex1 = j1;
 
-		if(commonFunction == prevFunction2 && !foundEdge2 && isCall(edge2.second, edge2.first))
+		if(isCommonFunction(prevFunction2) && !foundEdge2 && isCall(edge2.second, edge2.first))
 			lastCommonNodeIndex2 = j2;
-		else if(commonFunction == curFunction2 && foundEdge2)
+		else if(isCommonFunction(curFunction2) && foundEdge2)
 			lastCommonNodeIndex2 = 0;
 
 		if(j1 == 0) {
 			foundEdge1 = true;
 
-			if(commonFunction == curFunction1)
+			if(isCommonFunction(curFunction1))
 				lastCommonNodeIndex1 = 0;
 		} else 
 			j1--;
@@ -127,7 +134,7 @@ bool AnalysisContext::isReachable(const KSrcSnkDPItem &item1, const KSrcSnkDPIte
 		if(j2 == 0) {
 			foundEdge2 = true;
 
-			if(commonFunction == curFunction2)
+			if(isCommonFunction(curFunction2))
 				lastCommonNodeIndex2 = 0;
 		} else
 			j2--;
@@ -230,6 +237,19 @@ void SrcSnkAnalysisContext::sortPaths() {
 //	outs() << "\n";
 }
 
+void SrcSnkAnalysisContext::solvePaths(bool sort) {
+	if(!solved) {
+		AllPathReachableSolve();
+		filterUnreachablePaths();
+		solved = true;
+	}
+
+	if(sort && !sorted) {
+		sortPaths();
+		sorted = true;
+	}
+}
+
 void SrcSnkAnalysisContext::filterUnreachablePaths() {
 	for(auto it = sinkPaths.begin(); it != sinkPaths.end();) {
 		NodeIDPair key = it->first;	
@@ -0,0 +1,160 @@
+#include "Util/AnalysisServer.h"
+#include "Util/KernelAnalysisUtil.h"
+#include <llvm/Support/raw_ostream.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+
+using namespace llvm;
+
+// Socket of the client, only set within a request handler.
+static int clientSocket = -1;
+
+// Max. length of a request line.
+static const size_t MAX_REQUEST_LENGTH = 4096;
+
+AnalysisServer::~AnalysisServer() {
+	if(serverFd >= 0) {
+		close(serverFd);
+		unlink(socketPath.c_str());
+	}
+	serverFd = -1;
+}
+
+bool AnalysisServer::isHandlingRequest() {
+	return clientSocket >= 0;
+}
+
+void AnalysisServer::sendResult(const std::string &msg) {
+	const char *data = msg.data();
+	size_t len = msg.size();
+
+	while(len > 0) {
+		ssize_t written = send(clientSocket, data, len, MSG_NOSIGNAL);
+
+		if(written < 0) {
+			if(errno == EINTR)
+				continue;
+			errs() << "Warning: Could not send result to the client!\n";
+			return;
+		}
+
+		data += written;
+		len -= written;
+	}
+}
+
+void AnalysisServer::reapHandlers(bool block) {
+	while(numHandlers > 0) {
+		pid_t pid = waitpid(-1, nullptr, block ? 0 : WNOHANG);
+
+		if(pid < 0 && errno == EINTR)
+			continue;
+		if(pid <= 0)
+			break;
+
+		numHandlers--;
+		block = false;
+	}
+}
+
+bool AnalysisServer::run(RequestHandler handler) {
+	struct sockaddr_un addr;
+
+	if(socketPath.size() >= sizeof(addr.sun_path)) {
+		errs() << "Warning: Socket path " << socketPath << " is too long!\n";
+		return false;
+	}
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+
+	// A previous server might have left its socket behind.
+	unlink(socketPath.c_str());
+
+	serverFd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+	// The socket is created with mode 0600, a request runs with the rights of the server.
+	mode_t oldMask = umask(0177);
+	bool bound = serverFd >= 0 && bind(serverFd, (struct sockaddr*)&addr, sizeof(addr)) == 0;
+	umask(oldMask);
+
+	if(!bound || listen(serverFd, 16) != 0) {
+		errs() << "Warning: Could not listen on " << socketPath << ": " << strerror(errno) << "\n";
+		return false;
+	}
+
+	outs() << "Serving requests on " << socketPath << "\n";
+
+	while(true) {
+		// Wait for a free handler before the next client is accepted.
+		if(numHandlers >= maxHandlers)
+			reapHandlers(true);
+
+		int clientFd = accept(serverFd, nullptr, nullptr);
+
+		if(clientFd < 0) {
+			if(errno == EINTR)
+				continue;
+			errs() << "Warning: Accepting a client failed: " << strerror(errno) << "\n";
+			break;
+		}
+
+		// Reap the handlers of previous requests.
+		reapHandlers(false);
+
+		pid_t pid = analysisUtil::forkAnalysisProcess();
+
+		if(pid == 0) {
+			close(serverFd);
+			serverFd = -1;
+
+			handleClient(clientFd, handler);
+
+			close(clientFd);
+			outs().flush();
+			errs().flush();
+			_exit(0);
+		}
+
+		if(pid < 0)
+			errs() << "Warning: Could not fork a request handler!\n";
+		else
+			numHandlers++;
+
+		close(clientFd);
+	}
+
+	return true;
+}
+
+void AnalysisServer::handleClient(int clientFd, RequestHandler handler) {
+	std::string request;
+	char c;
+
+	while(request.size() < MAX_REQUEST_LENGTH) {
+		ssize_t len = recv(clientFd, &c, 1, 0);
+
+		if(len < 0 && errno == EINTR)
+			continue;
+		if(len <= 0 || c == '\n')
+			break;
+
+		request += c;
+	}
+
+	if(!request.empty() && request.back() == '\r')
+		request.pop_back();
+
+	outs() << "Request: " << request << "\n";
+
+	clientSocket = clientFd;
+	handler(request);
+	clientSocket = -1;
+}
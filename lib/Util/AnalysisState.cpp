@@ -0,0 +1,89 @@
+#include "Util/AnalysisState.h"
+#include "Util/KMinerStat.h"
+#include "KernelModels/KernelContext.h"
+#include "KernelModels/InitcallFactory.h"
+#include "Checker/SrcSnkAnalysis.h"
+#include "SVF/MemoryModel/PAG.h"
+#include "SVF/WPA/Andersen.h"
+#include "SVF/WPA/FlowSensitive.h"
+
+// Schedulers of the use-after-return checkers.
+extern UARWorkList *uar_global_worklist;
+extern BoolVec *uar_sched_threads;
+extern UARLiteWorkList *global_worklist;
+extern BoolVec *sched_threads;
+
+AnalysisState* AnalysisState::activeState = nullptr;
+
+/**
+ * Helper function that exchanges two pointers.
+ */
+template<typename T>
+static void swapInstance(T *&a, T *&b) {
+	T *tmp = a;
+	a = b;
+	b = tmp;
+}
+
+AnalysisState::~AnalysisState() {
+	if(activeState != this)
+		activate();
+
+	release();
+	deactivate();
+}
+
+void AnalysisState::activate() {
+	assert(activeState == nullptr && "Another state is still active!");
+
+	swapState();
+	activeState = this;
+}
+
+void AnalysisState::deactivate() {
+	assert(activeState == this && "Only the active state can be deactivated!");
+
+	swapState();
+	activeState = nullptr;
+}
+
+void AnalysisState::swapState() {
+	pag = PAG::swapPAG(pag);
+	symInfo = SymbolTableInfo::swapSymbolnfo(symInfo, symModule);
+	ander = AndersenWaveDiff::swapAndersenWaveDiff(ander);
+	fspta = FlowSensitive::swapFSWPA(fspta);
+
+	kernelCxt = KernelContext::swapKernelContext(kernelCxt);
+	kminerStat = KMinerStat::swapKMinerStat(kminerStat);
+	initcallFactory = InitcallFactory::swapInitcallFactory(initcallFactory);
+	pathCondAllocator = SrcSnkAnalysis::swapPathCondAllocator(pathCondAllocator);
+
+	swapInstance(uarGlobalWorklist, uar_global_worklist);
+	swapInstance(uarSchedThreads, uar_sched_threads);
+	swapInstance(uarlGlobalWorklist, global_worklist);
+	swapInstance(uarlSchedThreads, sched_threads);
+}
+
+void AnalysisState::release() {
+	assert(activeState == this && "Only the active state can be released!");
+
+	// The pointer analyses refer to the PAG, which owns the symbol table.
+	FlowSensitive::releaseFSWPA();
+	AndersenWaveDiff::releaseAndersenWaveDiff();
+	PAG::releasePAG();
+
+	delete SrcSnkAnalysis::swapPathCondAllocator(nullptr);
+
+	InitcallFactory::releaseInitcallFactory();
+	KernelContext::releaseKernelContext();
+	KMinerStat::releaseKMinerStat();
+
+	delete uar_global_worklist;
+	delete uar_sched_threads;
+	delete global_worklist;
+	delete sched_threads;
+	uar_global_worklist = nullptr;
+	uar_sched_threads = nullptr;
+	global_worklist = nullptr;
+	sched_threads = nullptr;
+}
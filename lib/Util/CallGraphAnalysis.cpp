@@ -7,6 +7,7 @@
 #include <llvm/IR/Operator.h>
 #include <sstream>
 #include <fstream>
+#include <deque>
 
 StringSet LocalCallGraphAnalysis::blacklist;
 
@@ -45,18 +46,93 @@ void LocalCallGraphAnalysis::analyze(std::string startFunc, bool forward,
 		backwardTraverse(item);
 }
 
+void LocalCallGraphAnalysis::analyzeDepths(const StringSet &startFuncs) {
+	std::deque<std::pair<NodeID, uint32_t>> worklist;
+
+	reset();
+	clearVisitedSet();
+	broad = false;
+	recordDepths = true;
+
+	for(const auto &iter : startFuncs) {
+		const llvm::Function *F = getGraph()->getModule()->getFunction(iter);
+
+		if(F == nullptr)
+			F = findAliasFunc(iter);
+
+		if(F == nullptr)
+			continue;
+
+		const PTACallGraphNode *node = getGraph()->getCallGraphNode(F);
+
+		if(!hasVisited(node)) {
+			addVisited(node);
+			worklist.push_back(std::make_pair(node->getId(), 0));
+		}
+	}
+
+	// Breadth-first, so every function and variable is reached at its minimal depth first.
+	while(!worklist.empty()) {
+		GNODE *node = getNode(worklist.front().first);
+		uint32_t depth = worklist.front().second;
+		worklist.pop_front();
+
+		const llvm::Function *F = node->getFunction();
+		uint32_t id = ValueIDMap::getValueIDMap()->getID(F);
+
+		if(forwardFilter.test(id))
+			continue;
+
+		if(inBlackList(F, id))
+			continue;
+
+		funcDepths[F->getName()] = depth;
+
+		if(depth > actualDepth)
+			actualDepth = depth;
+
+		// The global variables found within the function get its depth.
+		CGDPItem item(node->getId(), depth, NodeIdList());
+
+		for(auto II = inst_begin(*F); II != inst_end(*F); ++II) {
+			llvm::Instruction *inst = const_cast<llvm::Instruction*>(&*II);
+
+			if(analysisUtil::isCallSite(inst)) {
+				llvm::CallSite CS(cast<Value>(inst));
+				handleCallSite(item, &CS);
+			} else {
+				handleAssignments(item, inst);
+			}
+		}
+
+		for(auto EI = GTraits::child_begin(node), EE = GTraits::child_end(node); EI != EE; ++EI) {
+			const PTACallGraphNode *dstNode = getNode((*EI.getCurrent())->getDstID());
+
+			if(hasVisited(dstNode))
+				continue;
+
+			addVisited(dstNode);
+			worklist.push_back(std::make_pair(dstNode->getId(), depth + 1));
+		}
+	}
+
+	recordDepths = false;
+}
+
 bool LocalCallGraphAnalysis::forwardChecks(const CGDPItem &item) {
 	const PTACallGraphNode *node = getNode(item.getCurNodeID());
-	std::string funcName = node->getFunction()->getName();
+	const llvm::Function *F = node->getFunction();
 
 	if(!item.validDepth())
 		return false;
 
-	if(forwardFilter && forwardFilter->find(funcName) != forwardFilter->end())
+	uint32_t id = ValueIDMap::getValueIDMap()->getID(F);
+
+	if(forwardFilter.test(id))
 		return false;
 
 	// maybe we dont want to forward the whole graph.
-	if(inBlackList(funcName)) 
+	if(inBlackList(F, id)) 
 		return false;
 
 	return true;
@@ -174,10 +250,9 @@ void LocalCallGraphAnalysis::forwardpropagate(const CGDPItem& item, FuncSet &fun
 
 bool LocalCallGraphAnalysis::backwardCheck(const CGDPItem &item) {
 	const PTACallGraphNode *node = getNode(item.getCurNodeID());
-	std::string funcName = node->getFunction()->getName();
 
 	// usually we dont want to backward the whole graph.
-	if(backwardFilter && backwardFilter->find(funcName) != backwardFilter->end())
+	if(backwardFilter.test(ValueIDMap::getValueIDMap()->getID(node->getFunction())))
 		return false;
 
 	return true;
@@ -287,6 +362,8 @@ void LocalCallGraphAnalysis::handleCE(const CGDPItem &item, const Value *val) {
 
 			if(isa<GlobalVariable>(ref) && !isRelevantGlobalVar(ref) && !isFunctionPtr(ref)) {
 				relevantGlobalVars.insert(ref->getName());
+				if(recordDepths)
+					globalVarDepths.emplace(ref->getName(), item.getDepth());
 				handleGlobalCE(item, dyn_cast<GlobalVariable>(ref));
 			}
 		}
@@ -442,6 +519,20 @@ bool LocalCallGraphAnalysis::inBlackList(std::string funcName) const {
 //		LocalCallGraphAnalysis::blacklist.end();	
 }
 
+bool LocalCallGraphAnalysis::inBlackList(const llvm::Function *F, uint32_t id) {
+	if(!hasBlackList())
+		return false;
+
+	if(!blackListChecked.test(id)) {
+		blackListChecked.set(id);
+
+		if(inBlackList(F->getName()))
+			blackListed.set(id);
+	}
+
+	return blackListed.test(id);
+}
+
 bool LocalCallGraphAnalysis::hasBlackList() const {
 	return !LocalCallGraphAnalysis::blacklist.empty(); 
 }
@@ -0,0 +1,181 @@
+#include "Util/CallGraphReachability.h"
+
+using namespace llvm;
+
+CallGraphReachability::CallGraphReachability(PTACallGraph *callGraph, const StringSet &barriers):
+	callGraph(callGraph),
+	numNodes(callGraph->getTotalNodeNum()),
+	numIndCallEdges(callGraph->getNumOfResolvedIndCallEdge()) {
+
+	for(const auto &iter : *callGraph)
+		funcToNode[iter.second->getFunction()] = iter.first;
+
+	for(const auto &iter : barriers) {
+		auto node = funcToNode.find(callGraph->getModule()->getFunction(iter));
+
+		if(node != funcToNode.end())
+			barrierNodes.set(node->second);
+	}
+
+	build();
+}
+
+void CallGraphReachability::build() {
+	std::map<NodeID, uint32_t> index, lowLink;
+	std::vector<NodeID> stack;
+	NodeBS onStack;
+	uint32_t nextIndex = 0;
+
+	// Iterative Tarjan, the components are found in reverse topological order.
+	for(const auto &root : *callGraph) {
+		if(index.count(root.first))
+			continue;
+
+		std::vector<std::pair<NodeID, PTACallGraphNode::const_iterator>> callStack;
+		const PTACallGraphNode *rootNode = root.second;
+
+		index[root.first] = lowLink[root.first] = nextIndex++;
+		stack.push_back(root.first);
+		onStack.set(root.first);
+		callStack.push_back(std::make_pair(root.first, rootNode->OutEdgeBegin()));
+
+		while(!callStack.empty()) {
+			NodeID id = callStack.back().first;
+			const PTACallGraphNode *node = callGraph->getCallGraphNode(id);
+			auto &edgeIter = callStack.back().second;
+
+			if(edgeIter != node->OutEdgeEnd()) {
+				NodeID dst = (*edgeIter)->getDstID();
+				++edgeIter;
+
+				if(barrierNodes.test(dst))
+					continue;
+
+				if(!index.count(dst)) {
+					index[dst] = lowLink[dst] = nextIndex++;
+					stack.push_back(dst);
+					onStack.set(dst);
+					callStack.push_back(std::make_pair(dst, callGraph->getCallGraphNode(dst)->OutEdgeBegin()));
+				} else if(onStack.test(dst)) {
+					lowLink[id] = std::min(lowLink[id], index[dst]);
+				}
+
+				continue;
+			}
+
+			callStack.pop_back();
+
+			if(!callStack.empty()) {
+				NodeID parent = callStack.back().first;
+				lowLink[parent] = std::min(lowLink[parent], lowLink[id]);
+			}
+
+			if(lowLink[id] != index[id])
+				continue;
+
+			uint32_t scc = sccMembers.size();
+			NodeID member;
+
+			sccMembers.push_back(NodeBS());
+
+			do {
+				member = stack.back();
+				stack.pop_back();
+				onStack.reset(member);
+				nodeToSCC[member] = scc;
+				sccMembers[scc].set(member);
+			} while(member != id);
+		}
+	}
+
+	uint32_t numSCCs = sccMembers.size();
+
+	descendants.assign(numSCCs, BitVector(numSCCs));
+	ancestors.assign(numSCCs, BitVector(numSCCs));
+
+	// The callees of a component were found before the component itself.
+	for(uint32_t scc = 0; scc < numSCCs; scc++) {
+		descendants[scc].set(scc);
+
+		for(const auto &member : sccMembers[scc]) {
+			const PTACallGraphNode *node = callGraph->getCallGraphNode(member);
+
+			for(auto iter = node->OutEdgeBegin(); iter != node->OutEdgeEnd(); ++iter) {
+				NodeID dst = (*iter)->getDstID();
+				uint32_t dstSCC = nodeToSCC[dst];
+
+				if(!barrierNodes.test(dst) && dstSCC != scc)
+					descendants[scc] |= descendants[dstSCC];
+			}
+		}
+	}
+
+	// The callers of a component are handled before the component itself.
+	for(uint32_t scc = numSCCs; scc-- > 0;) {
+		ancestors[scc].set(scc);
+
+		for(const auto &member : sccMembers[scc]) {
+			const PTACallGraphNode *node = callGraph->getCallGraphNode(member);
+
+			for(auto iter = node->OutEdgeBegin(); iter != node->OutEdgeEnd(); ++iter) {
+				NodeID dst = (*iter)->getDstID();
+				uint32_t dstSCC = nodeToSCC[dst];
+
+				if(!barrierNodes.test(dst) && dstSCC != scc)
+					ancestors[dstSCC] |= ancestors[scc];
+			}
+		}
+	}
+}
+
+bool CallGraphReachability::getSCC(const llvm::Function *F, uint32_t &scc) const {
+	auto iter = funcToNode.find(F);
+
+	if(iter == funcToNode.end())
+		return false;
+
+	scc = nodeToSCC.at(iter->second);
+	return true;
+}
+
+bool CallGraphReachability::reaches(const llvm::Function *caller, const llvm::Function *callee) const {
+	uint32_t callerSCC, calleeSCC;
+
+	if(!getSCC(caller, callerSCC) || !getSCC(callee, calleeSCC))
+		return false;
+
+	return descendants[callerSCC].test(calleeSCC);
+}
+
+StringSet CallGraphReachability::getCalleeSlice(const llvm::Function *F) const {
+	uint32_t scc;
+
+	if(!getSCC(F, scc))
+		return StringSet();
+
+	return getFunctionNames(descendants[scc]);
+}
+
+StringSet CallGraphReachability::getCallerSlice(const llvm::Function *F) const {
+	uint32_t scc;
+
+	if(!getSCC(F, scc))
+		return StringSet();
+
+	return getFunctionNames(ancestors[scc]);
+}
+
+StringSet CallGraphReachability::getFunctionNames(const BitVector &sccs) const {
+	StringSet names;
+
+	for(int scc = sccs.find_first(); scc != -1; scc = sccs.find_next(scc)) {
+		for(const auto &member : sccMembers[scc]) {
+			const llvm::Function *F = callGraph->getCallGraphNode(member)->getFunction();
+
+			if(F->hasName())
+				names.insert(F->getName().str());
+		}
+	}
+
+	return names;
+}
@@ -0,0 +1,245 @@
+#include "Util/ContextWorkerPool.h"
+#include "Util/KernelAnalysisUtil.h"
+#include <llvm/Support/raw_ostream.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+#include <poll.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <list>
+
+using namespace llvm;
+
+// Write end of the result pipe, only set within a worker.
+static int resultPipe = -1;
+
+/**
+ * Helper function that writes the whole buffer, even if the pipe is full.
+ */
+static bool writeAll(int fd, const char *data, size_t len) {
+	while(len > 0) {
+		ssize_t written = write(fd, data, len);
+
+		if(written < 0) {
+			if(errno == EINTR)
+				continue;
+			return false;
+		}
+
+		data += written;
+		len -= written;
+	}
+
+	return true;
+}
+
+bool ContextWorkerPool::isWorker() {
+	return resultPipe >= 0;
+}
+
+void ContextWorkerPool::sendResult(const std::string &msg) {
+	uint32_t len = msg.size();
+
+	if(!writeAll(resultPipe, (const char*)&len, sizeof(len)) || !writeAll(resultPipe, msg.data(), len))
+		errs() << "Warning: Could not send result to the parent process!\n";
+}
+
+bool ContextWorkerPool::spawn(std::function<void()> work, const std::string &cxtRoot, uint64_t predictedMem) {
+	u32_t baseMem = 0, vmsize = 0;
+	int fds[2];
+
+	if(pipe(fds) != 0) {
+		errs() << "Warning: Could not create pipe for a worker!\n";
+		return false;
+	}
+
+	// The peak memory of the worker includes the pages it shares with the parent.
+	analysisUtil::getMemoryUsageKB(&baseMem, &vmsize);
+
+	pid_t pid = analysisUtil::forkAnalysisProcess();
+
+	if(pid == 0) {
+		// The worker doesn't need the pipes of its siblings.
+		for(const auto &iter : workers)
+			close(iter.fd);
+		close(fds[0]);
+		resultPipe = fds[1];
+
+		work();
+
+		close(resultPipe);
+		outs().flush();
+		errs().flush();
+		_exit(0);
+	}
+
+	close(fds[1]);
+
+	if(pid < 0) {
+		errs() << "Warning: Could not fork a worker!\n";
+		close(fds[0]);
+		return false;
+	}
+
+	workers.push_back(Worker{pid, fds[0], "", cxtRoot, predictedMem, baseMem});
+
+	return true;
+}
+
+void ContextWorkerPool::run(const StringList &cxtRoots, ContextJob job, ResultHandler handler, 
+		FailureHandler failureHandler) {
+	std::vector<std::string> jobs(cxtRoots.begin(), cxtRoots.end());
+	uint64_t reservedMem = 0;
+
+	if(memBudget > 0) {
+		// The largest contexts run first, so they don't end up in the tail of the sweep.
+		std::stable_sort(jobs.begin(), jobs.end(), [&](const std::string &a, const std::string &b) {
+			return predictMemory(a) > predictMemory(b);
+		});
+
+		outs() << "Schedule " << jobs.size() << " contexts within " << memBudget / 1024 << " MB.\n";
+	} else {
+		outs() << "Start " << numWorkers << " workers for " << jobs.size() << " contexts.\n";
+	}
+
+	std::list<std::string> pending(jobs.begin(), jobs.end());
+
+	while(!pending.empty() || !workers.empty()) {
+		// Launch the next contexts, with a budget only the largest ones that fit into its rest.
+		for(auto iter = pending.begin(); iter != pending.end() && workers.size() < numWorkers;) {
+			std::string cxtRoot = *iter;
+			uint64_t predictedMem = memBudget > 0 ? predictMemory(cxtRoot) : 0;
+
+			// A context that exceeds the whole budget runs alone.
+			if(reservedMem + predictedMem > memBudget && !workers.empty()) {
+				++iter;
+				continue;
+			}
+
+			if(predictedMem > memBudget)
+				errs() << "Warning: " << cxtRoot << " is predicted to exceed the memory budget!\n";
+
+			if(spawn([&job, cxtRoot]() { job(cxtRoot); }, cxtRoot, predictedMem)) {
+				reservedMem += predictedMem;
+			} else if(workers.empty()) {
+				// Without any worker the context is analyzed by the process itself.
+				job(cxtRoot);
+			} else {
+				break;
+			}
+
+			iter = pending.erase(iter);
+		}
+
+		if(workers.empty())
+			continue;
+
+		std::vector<struct pollfd> fds;
+
+		for(const auto &iter : workers)
+			fds.push_back({iter.fd, POLLIN, 0});
+
+		if(poll(fds.data(), fds.size(), -1) < 0) {
+			if(errno == EINTR)
+				continue;
+			errs() << "Warning: Polling the workers failed: " << strerror(errno) << "\n";
+			break;
+		}
+
+		// Backwards, so finished workers can be removed.
+		for(uint32_t i = fds.size(); i-- > 0;) {
+			if(fds[i].revents == 0 || readResults(workers[i], handler))
+				continue;
+
+			Worker worker = workers[i];
+			close(worker.fd);
+			workers.erase(workers.begin() + i);
+			reservedMem -= worker.predictedMem;
+
+			std::string reason;
+			uint64_t peakMem = waitForWorker(worker, reason);
+			auto size = cxtSizes.find(worker.cxtRoot);
+
+			if(reason != "" && failureHandler)
+				failureHandler(worker.cxtRoot, reason);
+
+			// Correct the prediction by the memory the context added to the shared kernel.
+
+			if(memBudget > 0 && size != cxtSizes.end() && size->second > 0 && peakMem > worker.baseMem)
+				memPerElement = std::max(memPerElement, (peakMem - worker.baseMem) / size->second);
+		}
+	}
+
+	for(const auto &iter : workers) {
+		std::string reason;
+
+		close(iter.fd);
+		waitForWorker(iter, reason);
+
+		if(reason != "" && failureHandler)
+			failureHandler(iter.cxtRoot, reason);
+	}
+
+	workers.clear();
+}
+
+uint64_t ContextWorkerPool::predictMemory(const std::string &cxtRoot) const {
+	auto iter = cxtSizes.find(cxtRoot);
+	uint64_t size = iter != cxtSizes.end() ? iter->second : 0;
+
+	return size * (memPerElement > 0 ? memPerElement : DEFAULT_MEM_PER_ELEMENT);
+}
+
+uint64_t ContextWorkerPool::waitForWorker(const Worker &worker, std::string &reason) {
+	struct rusage usage;
+	int status = 0;
+
+	memset(&usage, 0, sizeof(usage));
+
+	while(wait4(worker.pid, &status, 0, &usage) < 0 && errno == EINTR);
+
+	if(WIFSIGNALED(status))
+		reason = std::string("killed by ") + strsignal(WTERMSIG(status));
+	else if(WEXITSTATUS(status) != 0)
+		reason = "exit status " + std::to_string(WEXITSTATUS(status));
+
+	if(reason != "") {
+		errs() << "Warning: Worker " << worker.pid;
+		if(worker.cxtRoot != "")
+			errs() << " (" << worker.cxtRoot << ")";
+		errs() << " terminated abnormally (" << reason << ")!\n";
+	}
+
+	// Linux reports the peak resident memory in kB.
+	return usage.ru_maxrss;
+}
+
+bool ContextWorkerPool::readResults(Worker &worker, ResultHandler handler) {
+	char buf[4096];
+	ssize_t len = read(worker.fd, buf, sizeof(buf));
+
+	if(len > 0) {
+		worker.buffer.append(buf, len);
+		handleResults(worker, handler);
+		return true;
+	}
+
+	return len < 0 && errno == EINTR;
+}
+
+void ContextWorkerPool::handleResults(Worker &worker, ResultHandler handler) {
+	std::string &buffer = worker.buffer;
+	uint32_t len;
+
+	while(buffer.size() >= sizeof(len)) {
+		memcpy(&len, buffer.data(), sizeof(len));
+
+		if(buffer.size() < sizeof(len) + len)
+			return;
+
+		handler(buffer.substr(sizeof(len), len));
+		buffer.erase(0, sizeof(len) + len);
+	}
+}
@@ -0,0 +1,187 @@
+#include "Util/CostModel.h"
+#include "Util/KMinerStat.h"
+#include <llvm/Support/raw_ostream.h>
+#include <fstream>
+#include <sstream>
+#include <cmath>
+#include <map>
+
+using namespace llvm;
+
+bool CostModel::load() {
+	std::ifstream in(historyFile.c_str());
+	std::string line;
+
+	while(std::getline(in, line)) {
+		std::istringstream record(line);
+		std::string cxtName;
+		Features features;
+		double duration;
+
+		if(!(record >> cxtName >> features.numFuncs >> features.numGVs >> features.cgDepth
+				>> features.numSources >> duration))
+			continue;
+
+		samples.push_back(std::make_pair(toVector(features), duration));
+		lastFeatures[cxtName] = features;
+	}
+
+	if(samples.empty())
+		return false;
+
+	fit();
+
+	outs() << "Cost model fitted to " << samples.size() << " analyzed contexts.\n";
+
+	return true;
+}
+
+void CostModel::fit() {
+	double meanDuration = 0;
+
+	meanFeatures.assign(NUM_WEIGHTS, 0);
+
+	for(const auto &iter : samples) {
+		for(uint32_t i = 0; i < NUM_WEIGHTS; i++)
+			meanFeatures[i] += iter.first[i] / samples.size();
+		meanDuration += iter.second / samples.size();
+	}
+
+	// Too few samples for a fit, every context costs the same.
+	weights.assign(NUM_WEIGHTS, 0);
+	weights[0] = meanDuration;
+
+	if(samples.size() < NUM_WEIGHTS)
+		return;
+
+	// Normal equations (X^T X) w = X^T y.
+	std::vector<std::vector<double>> A(NUM_WEIGHTS, std::vector<double>(NUM_WEIGHTS + 1, 0));
+
+	for(const auto &iter : samples) {
+		for(uint32_t i = 0; i < NUM_WEIGHTS; i++) {
+			for(uint32_t j = 0; j < NUM_WEIGHTS; j++)
+				A[i][j] += iter.first[i] * iter.first[j];
+			A[i][NUM_WEIGHTS] += iter.first[i] * iter.second;
+		}
+	}
+
+	// A small ridge keeps features that never vary (e.g. no sources) solvable.
+	for(uint32_t i = 1; i < NUM_WEIGHTS; i++)
+		A[i][i] += A[i][i] * 1e-6 + 1e-9;
+
+	// Gaussian elimination with partial pivoting.
+	for(uint32_t col = 0; col < NUM_WEIGHTS; col++) {
+		uint32_t pivot = col;
+
+		for(uint32_t row = col + 1; row < NUM_WEIGHTS; row++) {
+			if(std::fabs(A[row][col]) > std::fabs(A[pivot][col]))
+				pivot = row;
+		}
+
+		if(std::fabs(A[pivot][col]) < 1e-12)
+			return;
+
+		std::swap(A[col], A[pivot]);
+
+		for(uint32_t row = 0; row < NUM_WEIGHTS; row++) {
+			if(row == col)
+				continue;
+
+			double factor = A[row][col] / A[col][col];
+
+			for(uint32_t k = col; k <= NUM_WEIGHTS; k++)
+				A[row][k] -= factor * A[col][k];
+		}
+	}
+
+	for(uint32_t i = 0; i < NUM_WEIGHTS; i++)
+		weights[i] = A[i][NUM_WEIGHTS] / A[i][i];
+}
+
+double CostModel::predict(const std::string &cxtName) const {
+	if(weights.empty())
+		return 0;
+
+	auto iter = lastFeatures.find(cxtName);
+
+	if(iter == lastFeatures.end())
+		return evaluate(meanFeatures);
+
+	return evaluate(toVector(iter->second));
+}
+
+void CostModel::orderContexts(StringList &cxtRoots) const {
+	std::map<std::string, double> durations;
+
+	for(const auto &iter : cxtRoots)
+		durations[iter] = predict(iter);
+
+	// The longest contexts run first, so they don't end up in the tail of the sweep.
+	cxtRoots.sort([&](const std::string &a, const std::string &b) {
+		return durations[a] > durations[b];
+	});
+}
+
+void CostModel::planBudgets(const StringList &cxtRoots, double deadline, uint32_t numParallel) {
+	uint32_t parallel = numParallel > 0 ? numParallel : 1;
+	double totalDuration = 0;
+
+	for(const auto &iter : cxtRoots)
+		totalDuration += predict(iter);
+
+	if(totalDuration <= 0)
+		return;
+
+	// Contexts are slowed down or given slack alike, until the sweep fits the deadline.
+	double scale = deadline * parallel / totalDuration;
+
+	for(const auto &iter : cxtRoots)
+		timeBudgets[iter] = predict(iter) * scale;
+
+	if(scale < 1)
+		errs() << "Warning: The predicted sweep takes " << (int)(totalDuration / parallel) 
+			<< " sec, the budgets of the contexts are shortened to fit the deadline!\n";
+}
+
+double CostModel::evaluate(const std::vector<double> &x) const {
+	double duration = 0;
+
+	for(uint32_t i = 0; i < NUM_WEIGHTS; i++)
+		duration += weights[i] * x[i];
+
+	// A linear fit might predict negative durations for small contexts.
+	return duration > 0 ? duration : 0;
+}
+
+void CostModel::record(const std::string &cxtName, const Features &features, double duration) const {
+	std::ostringstream line;
+
+	line << cxtName << " " << features.numFuncs << " " << features.numGVs << " " << features.cgDepth
+		<< " " << features.numSources << " " << duration << "\n";
+
+	// The workers of a sweep append to the same history, so a record is written at once.
+	std::ofstream file(historyFile.c_str(), std::ios::app);
+	file << line.str() << std::flush;
+
+	if(!file)
+		errs() << "Warning: Could not write the cost history " << historyFile << "!\n";
+}
+
+CostModel::Features CostModel::collectFeatures(const KMinerStat &stat) {
+	const PartitionerStat &partStat = stat.getPartitionerStat();
+	Features features;
+
+	features.numFuncs = partStat.getNumKRFuncs();
+	features.numGVs = partStat.getNumKRGVs();
+	features.cgDepth = partStat.getARCGDepth();
+
+	for(const auto &iter : stat.getCheckerStats())
+		features.numSources += iter.getNumAnalyzedVar();
+
+	return features;
+}
+
+std::vector<double> CostModel::toVector(const Features &features) {
+	return {1.0, (double)features.numFuncs, (double)features.numGVs,
+		(double)features.cgDepth, (double)features.numSources};
+}
@@ -0,0 +1,100 @@
+#include "Util/DebugInfoIndex.h"
+#include <llvm/ADT/StringMap.h>
+
+using namespace llvm;
+
+DebugInfoIndex* DebugInfoIndex::debugInfoIndex = nullptr;
+
+void DebugInfoIndex::addModule(const llvm::Module &module) {
+	std::map<const llvm::Function*, DISubprogram*> funcToSP;
+	StringMap<DISubprogram*> nameToSP;
+	std::map<const llvm::Value*, DIGlobalVariable*> valueToGV;
+	NamedMDNode *CU_Nodes = module.getNamedMetadata("llvm.dbg.cu");
+
+	if(CU_Nodes) {
+		for (unsigned i = 0, e = CU_Nodes->getNumOperands(); i != e; ++i) {
+			DICompileUnit *CUNode = cast<DICompileUnit>(CU_Nodes->getOperand(i));
+
+			// The first subprogram describing a function wins, like DISubprogram::describes.
+			for (DISubprogram *SP : CUNode->getSubprograms()) {
+				if (const llvm::Function *F = mdconst::dyn_extract_or_null<llvm::Function>(SP->getRawFunction()))
+					funcToSP.insert(std::make_pair(F, SP));
+
+				StringRef name = SP->getLinkageName().empty() ? SP->getName() : SP->getLinkageName();
+				nameToSP.insert(std::make_pair(name, SP));
+			}
+
+			// The last debug info of a global variable wins, like analysisUtil::getSourceLine.
+			for (DIGlobalVariable *GV : CUNode->getGlobalVariables())
+				valueToGV[GV->getVariable()] = GV;
+		}
+	}
+
+	for(const auto &iter : module) {
+		if(subprograms.find(&iter) != subprograms.end())
+			continue;
+
+		auto spIter = funcToSP.find(&iter);
+
+		if(spIter != funcToSP.end()) {
+			subprograms[&iter] = spIter->second;
+			continue;
+		}
+
+		auto nameIter = nameToSP.find(iter.getName());
+		subprograms[&iter] = nameIter != nameToSP.end() ? nameIter->second : nullptr;
+	}
+
+	for(const auto &iter : module.globals()) {
+		if(globalVariables.find(&iter) != globalVariables.end())
+			continue;
+
+		auto gvIter = valueToGV.find(&iter);
+		globalVariables[&iter] = gvIter != valueToGV.end() ? gvIter->second : nullptr;
+	}
+}
+
+DISubprogram* DebugInfoIndex::getSubprogram(const llvm::Function *F) {
+	auto iter = subprograms.find(F);
+
+	if(iter != subprograms.end())
+		return iter->second;
+
+	NamedMDNode *CU_Nodes = F->getParent()->getNamedMetadata("llvm.dbg.cu");
+
+	if(CU_Nodes) {
+		for (unsigned i = 0, e = CU_Nodes->getNumOperands(); i != e; ++i) {
+			DICompileUnit *CUNode = cast<DICompileUnit>(CU_Nodes->getOperand(i));
+
+			for (DISubprogram *SP : CUNode->getSubprograms()) {
+				if (SP->describes(F))
+					return SP;
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+DIGlobalVariable* DebugInfoIndex::getGlobalVariable(const llvm::GlobalVariable *GV) {
+	auto iter = globalVariables.find(GV);
+
+	if(iter != globalVariables.end())
+		return iter->second;
+
+	NamedMDNode *CU_Nodes = GV->getParent()->getNamedMetadata("llvm.dbg.cu");
+	DIGlobalVariable *DIGV = nullptr;
+
+	if(CU_Nodes) {
+		for (unsigned i = 0, e = CU_Nodes->getNumOperands(); i != e; ++i) {
+			DICompileUnit *CUNode = cast<DICompileUnit>(CU_Nodes->getOperand(i));
+
+			for (DIGlobalVariable *G : CUNode->getGlobalVariables()) {
+				if (G->getVariable() == GV)
+					DIGV = G;
+			}
+		}
+	}
+
+	return DIGV;
+}
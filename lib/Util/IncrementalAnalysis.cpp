@@ -0,0 +1,206 @@
+#include "Util/IncrementalAnalysis.h"
+#include "Util/KernelAnalysisUtil.h"
+#include "Util/ReportPass.h"
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/IR/InlineAsm.h>
+#include <llvm/IR/Metadata.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/raw_ostream.h>
+#include <fstream>
+#include <algorithm>
+#include <cstdio>
+#include <unistd.h>
+
+using namespace llvm;
+
+/**
+ * Helper function that returns the hex digest of the given string.
+ */
+static std::string getMD5(StringRef data) {
+	MD5 hash;
+	MD5::MD5Result result;
+	SmallString<32> digest;
+
+	hash.update(data);
+	hash.final(result);
+	MD5::stringifyResult(result, digest);
+
+	return digest.str();
+}
+
+/**
+ * Hashes the IR of a function. Local values are numbered and debug information
+ * is skipped, so only changes of the code itself lead to a different hash.
+ */
+static std::string hashFunction(const Function &F) {
+	DenseMap<const Value*, uint32_t> slots;
+	std::string str;
+	raw_string_ostream os(str);
+
+	uint32_t slot = 0;
+
+	for(const auto &arg : F.args())
+		slots[&arg] = slot++;
+
+	for(const auto &BB : F) {
+		slots[&BB] = slot++;
+		for(const auto &I : BB)
+			slots[&I] = slot++;
+	}
+
+	F.getFunctionType()->print(os);
+	os << " " << F.getLinkage() << " " << F.isVarArg() << "\n";
+
+	for(const auto &BB : F) {
+		os << "%" << slots[&BB] << ":\n";
+
+		for(const auto &I : BB) {
+			os << I.getOpcodeName() << " ";
+			I.getType()->print(os);
+
+			if(const CmpInst *cmp = dyn_cast<CmpInst>(&I))
+				os << " " << cmp->getPredicate();
+
+			for(const auto &op : I.operands()) {
+				const Value *V = op.get();
+				os << ", ";
+
+				if(isa<MetadataAsValue>(V))
+					os << "!md";
+				else if(const GlobalValue *GV = dyn_cast<GlobalValue>(V))
+					os << "@" << GV->getName();
+				else if(isa<Constant>(V) || isa<InlineAsm>(V))
+					V->print(os);
+				else
+					os << "%" << slots.lookup(V);
+			}
+
+			os << "\n";
+		}
+	}
+
+	return getMD5(os.str());
+}
+
+/**
+ * Hashes the type and the initializer of a global variable.
+ */
+static std::string hashGlobalVar(const GlobalVariable &GV) {
+	std::string str;
+	raw_string_ostream os(str);
+
+	GV.getValueType()->print(os);
+	os << " " << GV.getLinkage() << " " << GV.isConstant() << "\n";
+
+	if(GV.hasInitializer())
+		GV.getInitializer()->print(os);
+
+	return getMD5(os.str());
+}
+
+const std::string& IncrementalAnalysis::getHash(llvm::Module &hashModule, char kind, const std::string &name) {
+	auto key = std::make_pair(kind, name);
+	auto iter = hashes.find(key);
+
+	if(iter != hashes.end())
+		return iter->second;
+
+	std::string &hash = hashes[key];
+	hash = "-";
+
+	if(kind == 'F') {
+		if(llvm::Function *F = hashModule.getFunction(name)) {
+			// The body might not have been loaded yet.
+			analysisUtil::materializeFunctions(hashModule, StringSet({name}), false);
+			hash = hashFunction(*F);
+		}
+	} else if(const GlobalVariable *GV = hashModule.getNamedGlobal(name)) {
+		hash = hashGlobalVar(*GV);
+	}
+
+	return hash;
+}
+
+std::string IncrementalAnalysis::getArtifactFile(const std::string &cxtName) const {
+	std::string fileName = cxtName;
+
+	// Driver contexts are named by their path.
+	std::replace(fileName.begin(), fileName.end(), '/', '_');
+
+	return artifactDir + "/" + fileName + ".cxt";
+}
+
+bool IncrementalAnalysis::carryForward(const std::string &cxtName) {
+	std::ifstream in(getArtifactFile(cxtName).c_str());
+	std::string tag, cxtConfig;
+	uint32_t num = 0;
+
+	if(!in || !(in >> tag >> cxtConfig) || tag != "config" || cxtConfig != config)
+		return false;
+
+	if(!(in >> tag >> num) || tag != "deps")
+		return false;
+
+	for(uint32_t i = 0; i < num; i++) {
+		char kind;
+		std::string name, hash;
+
+		if(!(in >> kind >> name >> hash) || getHash(module, kind, name) != hash)
+			return false;
+	}
+
+	if(!(in >> tag >> num) || tag != "report")
+		return false;
+
+	// Skip the line break after the size.
+	in.get();
+
+	std::string report(num, '\0');
+	if(num > 0 && !in.read(&report[0], num))
+		return false;
+
+	outs() << "Unchanged context " << cxtName << ", report carried forward\n";
+	ReportPass::writeToReport(report);
+	numCarriedForward++;
+
+	return true;
+}
+
+void IncrementalAnalysis::recordDependencies(llvm::Module &cxtModule, const StringSet &functions,
+		const StringSet &globalVars) {
+	deps.clear();
+
+	for(const auto &name : functions)
+		deps.push_back(std::make_pair(std::make_pair('F', name), getHash(cxtModule, 'F', name)));
+
+	for(const auto &name : globalVars)
+		deps.push_back(std::make_pair(std::make_pair('G', name), getHash(cxtModule, 'G', name)));
+}
+
+void IncrementalAnalysis::storeContext(const std::string &cxtName, const std::string &report) {
+	std::string fileName = getArtifactFile(cxtName);
+	std::string tmpFileName = fileName + "." + std::to_string(getpid());
+
+	std::ofstream out(tmpFileName.c_str());
+
+	if(!out) {
+		errs() << "Warning: Could not write the artifacts of " << cxtName << "!\n";
+		return;
+	}
+
+	out << "config " << config << "\n";
+	out << "deps " << deps.size() << "\n";
+
+	for(const auto &iter : deps)
+		out << iter.first.first << " " << iter.first.second << " " << iter.second << "\n";
+
+	out << "report " << report.size() << "\n" << report;
+	out.close();
+
+	if(std::rename(tmpFileName.c_str(), fileName.c_str()) != 0) {
+		errs() << "Warning: Could not write the artifacts of " << cxtName << "!\n";
+		std::remove(tmpFileName.c_str());
+	}
+
+	deps.clear();
+}
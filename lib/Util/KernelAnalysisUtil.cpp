@@ -1,12 +1,17 @@
 #include "Util/KernelAnalysisUtil.h"
+#include "Util/DebugInfoIndex.h"
 #include <llvm/Transforms/Utils/Local.h>
 #include <llvm/IR/Module.h>	
 #include <llvm/Support/CommandLine.h>
 #include <llvm/IR/InstIterator.h>
 #include <llvm/Analysis/CFG.h>	
 #include <llvm/IR/CFG.h>
+#include <llvm/Transforms/Utils/Cloning.h>
+#include <llvm/Transforms/Utils/ValueMapper.h>
 #include "SVF/Util/Conditions.h"
 #include <sys/resource.h>
+#include <unistd.h>
+#include <omp.h>
 #include <sstream>
 #include <fstream>
 #include <iostream>
@@ -68,19 +73,7 @@ bool analysisUtil::hasStructTypePointer(llvm::StructType *structTy) {
  */
 DISubprogram* analysisUtil::getDISubprogramOfFunction(const llvm::Function *F) 
 {
-	NamedMDNode* CU_Nodes = F->getParent()->getNamedMetadata("llvm.dbg.cu");
-	if(CU_Nodes) {
-		for (unsigned i = 0, e = CU_Nodes->getNumOperands(); i != e; ++i) {
-			DICompileUnit *CUNode = cast<DICompileUnit>(CU_Nodes->getOperand(i));
-			for (DISubprogram *SP : CUNode->getSubprograms()) {
-				if (SP->describes(F))
-					return SP;
-			}
-		}
-
-	}
-
-	return NULL;
+	return DebugInfoIndex::getDebugInfoIndex()->getSubprogram(F);
 }
 
 /*!
@@ -120,16 +113,10 @@ u32_t analysisUtil::getSourceLine(const Value* val) {
 		}
 	}
 	else if (const GlobalVariable* gvar = dyn_cast<GlobalVariable>(val)) {
-		NamedMDNode* CU_Nodes = gvar->getParent()->getNamedMetadata("llvm.dbg.cu");
-		if(CU_Nodes) {
-			for (unsigned i = 0, e = CU_Nodes->getNumOperands(); i != e; ++i) {
-				DICompileUnit *CUNode = cast<DICompileUnit>(CU_Nodes->getOperand(i));
-				for (DIGlobalVariable *GV : CUNode->getGlobalVariables()) {
-					if (gvar == GV->getVariable())
-						line = GV->getLine();
-				}
-			}
-		}
+		DIGlobalVariable *GV = DebugInfoIndex::getDebugInfoIndex()->getGlobalVariable(gvar);
+
+		if (GV)
+			line = GV->getLine();
 	}
 	else if (const Function* func = dyn_cast<Function>(val)) {
 		line = getSourceLineOfFunction(func);
@@ -176,16 +163,10 @@ std::string analysisUtil::getSourceFileName(const Value* val) {
 		}
 	}
 	else if (const GlobalVariable* gvar = dyn_cast<GlobalVariable>(val)) {
-		NamedMDNode* CU_Nodes = gvar->getParent()->getNamedMetadata("llvm.dbg.cu");
-		if(CU_Nodes) {
-			for (unsigned i = 0, e = CU_Nodes->getNumOperands(); i != e; ++i) {
-				DICompileUnit *CUNode = cast<DICompileUnit>(CU_Nodes->getOperand(i));
-				for (DIGlobalVariable *GV : CUNode->getGlobalVariables()) {
-					if (gvar == GV->getVariable())
-						fileName = GV->getFilename();
-				}
-			}
-		}
+		DIGlobalVariable *GV = DebugInfoIndex::getDebugInfoIndex()->getGlobalVariable(gvar);
+
+		if (GV)
+			fileName = GV->getFilename();
 	}
 	else if (const Function* func = dyn_cast<Function>(val)) {
 		fileName = getSourceFileNameOfFunction(func);
@@ -194,6 +175,33 @@ std::string analysisUtil::getSourceFileName(const Value* val) {
 	return fileName;
 }
 
+/*!
+ * Checks if the global variable stays in a minimized module.
+ */
+static bool isKeptGlobalVar(const llvm::GlobalVariable &GV, const StringSet &relevantGVs) {
+	//TODO Cause problems during the creation of the SVFG. Seems to be a bug in SVF. 
+	if(GV.getName() == "dev_attr_tolerant" || 
+	   GV.getName() == "dev_attr_monarch_timeout" || 
+	   GV.getName() == "dev_attr_ignore_ce" || 
+	   GV.getName() == "dev_attr_cmci_disabled" ||
+	   GV.getName() == "irq_stack_ptr" || 
+	   GV.getName() == "init_per_cpu__irq_stack_union")
+		return false;
+
+	return relevantGVs.find(GV.getName()) != relevantGVs.end();
+}
+
+/*!
+ * Checks if the function stays in a minimized module.
+ */
+static bool isKeptFunction(const llvm::Function &F, const StringSet &relevantFuncs) {
+	// TODO Cause problems if we want to remove it. seems to be a bug in llvm
+	if(F.getName() == "__bpf_prog_run")
+		return true;
+
+	return relevantFuncs.find(F.getName()) != relevantFuncs.end();
+}
+
 /*!
  * Removes the irrelevant functions and global variables from the module.
  */
@@ -204,16 +212,7 @@ void analysisUtil::minimizeModule(llvm::Module &module, const StringSet &relevan
 	for(auto iter = module.global_begin(); iter != module.global_end(); ++iter) {
 		llvm::GlobalVariable &GV = *iter;
 
-		if(relevantGVs.find(GV.getName()) == relevantGVs.end()) 
-			irrelevantGlobalVars.insert(&GV);
-
-		//TODO Cause problems during the creation of the SVFG. Seems to be a bug in SVF. 
-		if(GV.getName() == "dev_attr_tolerant" || 
-		   GV.getName() == "dev_attr_monarch_timeout" || 
-		   GV.getName() == "dev_attr_ignore_ce" || 
-		   GV.getName() == "dev_attr_cmci_disabled" ||
-		   GV.getName() == "irq_stack_ptr" || 
-		   GV.getName() == "init_per_cpu__irq_stack_union")
+		if(!isKeptGlobalVar(GV, relevantGVs))
 			irrelevantGlobalVars.insert(&GV);
 	}	
 
@@ -228,7 +227,7 @@ void analysisUtil::minimizeModule(llvm::Module &module, const StringSet &relevan
 	for(auto iter = module.begin(); iter != module.end(); ++iter) {
 		llvm::Function &F = *iter;
 
-		if(relevantFuncs.find(F.getName()) == relevantFuncs.end()) 
+		if(!isKeptFunction(F, relevantFuncs)) 
 			irrelevantFunctions.insert(&F);
 	}	
 
@@ -236,9 +235,6 @@ void analysisUtil::minimizeModule(llvm::Module &module, const StringSet &relevan
 	for(auto iter = irrelevantFunctions.begin(); iter != irrelevantFunctions.end(); ++iter) {
 		llvm::Function *F = *iter;
 
-		// TODO Cause problems if we want to remove it. seems to be a bug in llvm
-		if(F->getName() == "__bpf_prog_run")
-			continue;
 		// Doesn't work in all cases. (seems to be a bug)	
 		F->deleteBody();
 		F->replaceAllUsesWith(UndefValue::get(F->getType()));
@@ -246,6 +242,187 @@ void analysisUtil::minimizeModule(llvm::Module &module, const StringSet &relevan
 		F->eraseFromParent();
 	}	
 }
+
+/*!
+ * Creates a new module that only contains the relevant functions and global variables
+ * of the given module. Uses of everything else are replaced by undef, just like
+ * minimizeModule does, but without cloning the whole module first.
+ */
+std::unique_ptr<llvm::Module> analysisUtil::extractModule(const llvm::Module &module, 
+		const StringSet &relevantFuncs, const StringSet &relevantGVs) {
+	std::unique_ptr<llvm::Module> newModule = llvm::make_unique<llvm::Module>(module.getModuleIdentifier(), 
+			module.getContext());
+	newModule->setDataLayout(module.getDataLayout());
+	newModule->setTargetTriple(module.getTargetTriple());
+	newModule->setModuleInlineAsm(module.getModuleInlineAsm());
+
+	ValueToValueMapTy VMap;
+
+	// Create the declarations first, since the bodies and initializers refer to each other.
+	for(const auto &GV : module.globals()) {
+		if(!isKeptGlobalVar(GV, relevantGVs)) {
+			VMap[&GV] = UndefValue::get(GV.getType());
+			continue;
+		}
+
+		GlobalVariable *newGV = new GlobalVariable(*newModule, GV.getValueType(), GV.isConstant(), 
+				GV.getLinkage(), nullptr, GV.getName(), nullptr, GV.getThreadLocalMode(), 
+				GV.getType()->getAddressSpace());
+		newGV->copyAttributesFrom(&GV);
+		VMap[&GV] = newGV;
+	}
+
+	for(const auto &F : module) {
+		if(!isKeptFunction(F, relevantFuncs)) {
+			VMap[&F] = UndefValue::get(F.getType());
+			continue;
+		}
+
+		Function *newF = Function::Create(cast<FunctionType>(F.getValueType()), F.getLinkage(), 
+				F.getName(), newModule.get());
+		newF->copyAttributesFrom(&F);
+		VMap[&F] = newF;
+	}
+
+	for(const auto &GA : module.aliases()) {
+		const GlobalValue *aliasee = dyn_cast<GlobalValue>(GA.getAliasee()->stripPointerCasts());
+
+		// Aliases of aliases are dropped as well.
+		Value *mapped = aliasee ? VMap.lookup(aliasee) : nullptr;
+
+		if(!mapped || isa<UndefValue>(mapped)) {
+			VMap[&GA] = UndefValue::get(GA.getType());
+			continue;
+		}
+
+		GlobalAlias *newGA = GlobalAlias::create(GA.getValueType(), GA.getType()->getPointerAddressSpace(),
+				GA.getLinkage(), GA.getName(), newModule.get());
+		newGA->copyAttributesFrom(&GA);
+		VMap[&GA] = newGA;
+	}
+
+	// Copy the initializers, bodies and aliasees of the relevant values.
+	for(const auto &GV : module.globals()) {
+		GlobalVariable *newGV = dyn_cast<GlobalVariable>(VMap[&GV]);
+
+		if(newGV && GV.hasInitializer())
+			newGV->setInitializer(MapValue(GV.getInitializer(), VMap));
+	}
+
+	for(const auto &F : module) {
+		Function *newF = dyn_cast<Function>(VMap[&F]);
+
+		// Bodies that were never loaded stay declarations.
+		if(!newF || F.isDeclaration() || F.isMaterializable())
+			continue;
+
+		Function::arg_iterator destArg = newF->arg_begin();
+		for(const auto &arg : F.args()) {
+			destArg->setName(arg.getName());
+			VMap[&arg] = &*destArg++;
+		}
+
+		SmallVector<ReturnInst*, 8> returns;
+		CloneFunctionInto(newF, &F, VMap, true, returns);
+
+		if(F.hasPersonalityFn())
+			newF->setPersonalityFn(MapValue(F.getPersonalityFn(), VMap));
+	}
+
+	for(const auto &GA : module.aliases()) {
+		if(GlobalAlias *newGA = dyn_cast<GlobalAlias>(VMap[&GA]))
+			newGA->setAliasee(MapValue(GA.getAliasee(), VMap));
+	}
+
+	// Debug info and module flags.
+	for(const auto &NMD : module.named_metadata()) {
+		NamedMDNode *newNMD = newModule->getOrInsertNamedMetadata(NMD.getName());
+
+		for(unsigned i = 0; i < NMD.getNumOperands(); i++)
+			newNMD->addOperand(cast<MDNode>(MapMetadata(NMD.getOperand(i), VMap)));
+	}
+
+	return newModule;
+}
+
+/*!
+ * Collects the functions and global variables a constant refers to.
+ */
+static void collectReferencedValues(const llvm::Constant *C, std::vector<llvm::Function*> &funcs,
+		std::set<const llvm::Constant*> &visited) {
+	if(!visited.insert(C).second)
+		return;
+
+	if(const Function *F = dyn_cast<Function>(C)) {
+		funcs.push_back(const_cast<Function*>(F));
+		return;
+	}
+
+	if(const GlobalVariable *GV = dyn_cast<GlobalVariable>(C)) {
+		if(GV->hasInitializer())
+			collectReferencedValues(GV->getInitializer(), funcs, visited);
+		return;
+	}
+
+	if(const GlobalAlias *GA = dyn_cast<GlobalAlias>(C)) {
+		if(GA->getAliasee())
+			collectReferencedValues(GA->getAliasee(), funcs, visited);
+		return;
+	}
+
+	for(const auto &op : C->operands()) {
+		if(const Constant *opC = dyn_cast<Constant>(op))
+			collectReferencedValues(opC, funcs, visited);
+	}
+}
+
+/*!
+ * Loads the bodies of the given functions of a lazily loaded module. If transitive is set,
+ * the functions referenced by the loaded bodies (directly or via global variables) are
+ * loaded as well. Returns the number of functions that were loaded.
+ */
+uint32_t analysisUtil::materializeFunctions(llvm::Module &module, const StringSet &funcNames, bool transitive) {
+	std::vector<llvm::Function*> worklist;
+	std::set<const llvm::Constant*> visited;
+	std::set<const llvm::Function*> walkedFuncs;
+	uint32_t numMaterialized = 0;
+
+	for(const auto &iter : funcNames) {
+		if(llvm::Function *F = module.getFunction(iter))
+			worklist.push_back(F);
+	}
+
+	while(!worklist.empty()) {
+		llvm::Function *F = worklist.back();
+		worklist.pop_back();
+
+		if(!walkedFuncs.insert(F).second)
+			continue;
+
+		if(F->isMaterializable()) {
+			if(std::error_code EC = F->materialize()) {
+				errs() << "Warning: Could not load " << F->getName() << ": " << EC.message() << "\n";
+				continue;
+			}
+
+			numMaterialized++;
+		}
+
+		// Bodies that were loaded before (e.g. non-transitively) might still refer to unloaded ones.
+		if(!transitive || F->isDeclaration())
+			continue;
+
+		for(auto I = inst_begin(F), E = inst_end(F); I != E; ++I) {
+			for(const auto &op : I->operands()) {
+				if(const Constant *C = dyn_cast<Constant>(op))
+					collectReferencedValues(C, worklist, visited);
+			}
+		}
+	}
+
+	return numMaterialized;
+}
+
 /*!
  * Removes the variables that are not a structure pointer or an array nor a structure containing a 
  * nother structure pointer.
@@ -291,3 +468,25 @@ std::string analysisUtil::getAlias(const llvm::Module &module, std::string funcN
 
 	return alias;
 }
+
+// Set in processes that were forked after OpenMP started its threads.
+static bool forkedProcess = false;
+
+pid_t analysisUtil::forkAnalysisProcess() {
+	// Otherwise the buffered output would be printed by both processes.
+	outs().flush();
+	errs().flush();
+
+	pid_t pid = fork();
+
+	if(pid == 0) {
+		forkedProcess = true;
+		omp_set_num_threads(1);
+	}
+
+	return pid;
+}
+
+uint32_t analysisUtil::getMaxThreads(uint32_t numThreads) {
+	return forkedProcess ? 1 : numThreads;
+}
@@ -0,0 +1,95 @@
+#include "Util/NameMatcher.h"
+#include <deque>
+
+using namespace llvm;
+
+void NameMatcher::addPatterns(const StringSet &patterns, uint32_t category) {
+	assert(!compiled && "Patterns have to be added before the first match");
+
+	for(const auto &iter : patterns) {
+		uint32_t cur = 0;
+
+		for(char c : iter) {
+			auto next = nodes[cur].next.find(c);
+
+			if(next == nodes[cur].next.end()) {
+				nodes[cur].next[c] = nodes.size();
+				cur = nodes.size();
+				nodes.push_back(Node());
+			} else {
+				cur = next->second;
+			}
+		}
+
+		// An empty pattern is contained in every name.
+		nodes[cur].categories |= category;
+	}
+}
+
+void NameMatcher::compile() {
+	std::deque<uint32_t> worklist;
+
+	for(const auto &iter : nodes[0].next)
+		worklist.push_back(iter.second);
+
+	// Breadth first, so the fail link of a node is complete before its children.
+	while(!worklist.empty()) {
+		uint32_t cur = worklist.front();
+		worklist.pop_front();
+
+		for(const auto &iter : nodes[cur].next) {
+			char c = iter.first;
+			uint32_t child = iter.second;
+			uint32_t fail = nodes[cur].fail;
+
+			while(fail != 0 && nodes[fail].next.find(c) == nodes[fail].next.end())
+				fail = nodes[fail].fail;
+
+			auto failNext = nodes[fail].next.find(c);
+
+			if(failNext != nodes[fail].next.end() && failNext->second != child)
+				nodes[child].fail = failNext->second;
+
+			nodes[child].categories |= nodes[nodes[child].fail].categories;
+			worklist.push_back(child);
+		}
+	}
+
+	compiled = true;
+}
+
+uint32_t NameMatcher::match(const std::string &name) {
+	if(!compiled)
+		compile();
+
+	uint32_t categories = nodes[0].categories;
+	uint32_t cur = 0;
+
+	for(char c : name) {
+		auto next = nodes[cur].next.find(c);
+
+		while(cur != 0 && next == nodes[cur].next.end()) {
+			cur = nodes[cur].fail;
+			next = nodes[cur].next.find(c);
+		}
+
+		if(next != nodes[cur].next.end())
+			cur = next->second;
+
+		categories |= nodes[cur].categories;
+	}
+
+	return categories;
+}
+
+uint32_t NameMatcher::match(const llvm::Function *F) {
+	auto iter = cache.find(F);
+
+	if(iter != cache.end())
+		return iter->second;
+
+	uint32_t categories = match(F->getName().str());
+	cache[F] = categories;
+
+	return categories;
+}
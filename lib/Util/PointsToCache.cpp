@@ -0,0 +1,209 @@
+#include "Util/PointsToCache.h"
+#include "SVF/MemoryModel/PAG.h"
+#include <llvm/IR/InstIterator.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/raw_ostream.h>
+#include <fstream>
+#include <cstdio>
+#include <unistd.h>
+
+using namespace llvm;
+
+typedef std::pair<std::string, uint32_t> CallSiteKey;
+
+/**
+ * Callsites are identified by their function and their position within it.
+ */
+static CallSiteKey getCallSiteKey(const Instruction *inst) {
+	const Function *F = inst->getParent()->getParent();
+	uint32_t index = 0;
+
+	for(auto iter = inst_begin(F), end = inst_end(F); iter != end && &*iter != inst; ++iter)
+		index++;
+
+	return std::make_pair(F->getName().str(), index);
+}
+
+std::string PointsToCache::getKey(Andersen *pta) {
+	PAG *pag = pta->getPAG();
+	MD5 hash;
+	MD5::MD5Result result;
+	SmallString<32> key;
+	std::string buffer;
+	raw_string_ostream stream(buffer);
+
+	stream << pta->getAnalysisTy() << " " << pag->getTotalNodeNum() << " " << pag->getPAGEdgeNum() << "\n";
+
+	// The functions and globals pin the node IDs to the same values.
+	for(NodeID id = 0; id < pag->getTotalNodeNum(); id++) {
+		if(!pag->hasGNode(id))
+			continue;
+
+		const PAGNode *node = pag->getPAGNode(id);
+		stream << node->getNodeKind();
+		if(node->hasValue() && isa<GlobalValue>(node->getValue()))
+			stream << " " << node->getValue()->getName();
+		stream << "\n";
+	}
+
+	for(uint32_t kind = PAGEdge::Addr; kind <= PAGEdge::ThreadJoin; kind++) {
+		for(const auto &edge : pag->getEdgeSet(PAGEdge::PEDGEK(kind)))
+			stream << kind << " " << edge->getSrcID() << " " << edge->getDstID() << "\n";
+	}
+
+	hash.update(stream.str());
+	hash.final(result);
+	MD5::stringifyResult(result, key);
+
+	return key.str();
+}
+
+bool PointsToCache::load(Andersen *pta, Module &module, const std::string &key) {
+	PAG *pag = pta->getPAG();
+	ConstraintGraph *consCG = pta->getConstraintGraph();
+	uint32_t initialNodeNum = pag->getTotalNodeNum();
+	std::string fileName = getCacheFile(key);
+	std::ifstream in(fileName.c_str());
+
+	if(!in)
+		return false;
+
+	std::map<NodeID, PointsTo> ptsMap;
+	std::map<NodeID, NodeID> repMap;
+	std::map<CallSiteKey, StringSet> callMap;
+	std::string tag;
+	std::string edgeTag;
+	uint32_t numNodes = 0, numEdges = 0;
+
+	if(!(in >> tag >> numNodes >> edgeTag >> numEdges) || tag != "nodes" || edgeTag != "edges"
+	   || numNodes != initialNodeNum || numEdges != pag->getPAGEdgeNum()) {
+		errs() << "Warning: Points-to cache " << fileName << " doesn't match the module!\n";
+		return false;
+	}
+
+	while(in >> tag) {
+		bool valid = false;
+
+		if(tag == "gep") {
+			// Field nodes have to get the same IDs as in the stored run.
+			NodeID id = 0, base = 0;
+			Size_t offset = 0;
+
+			if(in >> id >> base >> offset && pag->hasGNode(base) && isa<FIObjPN>(pag->getPAGNode(base)))
+				valid = consCG->getGepObjNode(base, LocationSet(offset)) == id;
+		} else if(tag == "pts") {
+			NodeID id = 0, ptd = 0;
+			uint32_t num = 0;
+
+			valid = (in >> id >> num) && id < pag->getTotalNodeNum();
+			PointsTo &pts = ptsMap[id];
+
+			for(uint32_t i = 0; valid && i < num; i++) {
+				valid = (in >> ptd) && ptd < pag->getTotalNodeNum();
+				pts.set(ptd);
+			}
+		} else if(tag == "same") {
+			NodeID id = 0, rep = 0;
+
+			valid = (in >> id >> rep) && id < pag->getTotalNodeNum();
+			repMap[id] = rep;
+		} else if(tag == "call") {
+			std::string caller, callee;
+			uint32_t index = 0;
+
+			valid = static_cast<bool>(in >> caller >> index >> callee);
+			callMap[std::make_pair(caller, index)].insert(callee);
+		}
+
+		if(!valid) {
+			errs() << "Warning: Points-to cache " << fileName << " is corrupted!\n";
+			return false;
+		}
+	}
+
+	for(const auto &iter : pag->getIndirectCallsites()) {
+		llvm::CallSite cs = iter.first;
+		auto callIter = callMap.find(getCallSiteKey(cs.getInstruction()));
+
+		if(callIter == callMap.end())
+			continue;
+
+		for(const auto &callee : callIter->second) {
+			if(const Function *F = module.getFunction(callee))
+				pta->addCachedIndCall(cs, F);
+		}
+	}
+
+	for(const auto &iter : ptsMap)
+		pta->addCachedPts(iter.first, iter.second);
+
+	for(const auto &iter : repMap)
+		pta->addCachedPts(iter.first, ptsMap[iter.second]);
+
+	outs() << "Loaded points-to results " << key << "\n";
+
+	return true;
+}
+
+void PointsToCache::store(Andersen *pta, const std::string &key, NodeID numOfInitialNodes) {
+	PAG *pag = pta->getPAG();
+	ConstraintGraph *consCG = pta->getConstraintGraph();
+	uint32_t numNodes = pag->getTotalNodeNum();
+	std::string fileName = getCacheFile(key);
+	// Workers of a sweep might store the same entry, the rename makes it appear at once.
+	std::string tmpFileName = fileName + "." + std::to_string(getpid());
+	std::ofstream out(tmpFileName.c_str());
+
+	if(!out) {
+		errs() << "Warning: Could not write points-to cache " << fileName << "!\n";
+		return;
+	}
+
+	out << "nodes " << numOfInitialNodes << " edges " << pag->getPAGEdgeNum() << "\n";
+
+	for(NodeID id = numOfInitialNodes; id < numNodes; id++) {
+		GepObjPN *gepNode = dyn_cast<GepObjPN>(pag->getPAGNode(id));
+
+		// Only field nodes can be recreated.
+		if(gepNode == nullptr) {
+			out.close();
+			std::remove(tmpFileName.c_str());
+			return;
+		}
+
+		out << "gep " << id << " " << pag->getObjectNode(gepNode->getMemObj()) << " "
+		    << gepNode->getLocationSet().getOffset() << "\n";
+	}
+
+	for(NodeID id = 0; id < numNodes; id++) {
+		NodeID rep = consCG->sccRepNode(id);
+		const PointsTo &pts = pta->getPts(id);
+
+		if(pts.empty())
+			continue;
+
+		if(rep != id) {
+			out << "same " << id << " " << rep << "\n";
+			continue;
+		}
+
+		out << "pts " << id << " " << pts.count();
+		for(const auto &ptd : pts)
+			out << " " << ptd;
+		out << "\n";
+	}
+
+	for(const auto &iter : pta->getIndCallMap()) {
+		CallSiteKey key = getCallSiteKey(iter.first.getInstruction());
+
+		for(const auto &callee : iter.second)
+			out << "call " << key.first << " " << key.second << " " << callee->getName().str() << "\n";
+	}
+
+	out.close();
+
+	if(std::rename(tmpFileName.c_str(), fileName.c_str()) != 0) {
+		errs() << "Warning: Could not write points-to cache " << fileName << "!\n";
+		std::remove(tmpFileName.c_str());
+	}
+}
@@ -1,5 +1,7 @@
 #include "Util/ReportPass.h"
 #include "Util/SystemInfoUtil.h"
+#include "Util/ContextWorkerPool.h"
+#include "Util/AnalysisServer.h"
 #include <fstream>
 #include <iostream>
 #include <iomanip>
@@ -11,6 +13,10 @@ using namespace analysisUtil;
 
 char ReportPass::ID = 0;
 
+std::string ReportPass::lastReport;
+
+CostModel::Features ReportPass::lastFeatures;
+
 static cl::opt<std::string> ReportFile("report", cl::init(""),
 		cl::desc("Write all reports to this file"));
 
@@ -23,11 +29,23 @@ SystemStat systemStat;
 
 
 void ReportPass::makeReport() {
-	writeToReport(REPORT_BANNER);
-	writeToReport(stat->toString());
+	lastReport = REPORT_BANNER + stat->toString();
+	writeToReport(lastReport);
 }
 
 void ReportPass::writeToReport(std::string msg) {
+	// Workers hand their reports to the parent process which writes the file.
+	if(ContextWorkerPool::isWorker()) {
+		ContextWorkerPool::sendResult(msg);
+		return;
+	}
+
+	// Reports of a served request belong to the client.
+	if(AnalysisServer::isHandlingRequest()) {
+		AnalysisServer::sendResult(msg);
+		return;
+	}
+
 	if(ReportFile != "") {
 		std::ofstream file;
 		file.open(ReportFile, std::ios::app);
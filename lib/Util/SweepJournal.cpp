@@ -0,0 +1,100 @@
+#include "Util/SweepJournal.h"
+#include <llvm/Support/raw_ostream.h>
+#include <fstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+using namespace llvm;
+
+SweepJournal::~SweepJournal() {
+	if(fd >= 0)
+		close(fd);
+	fd = -1;
+}
+
+bool SweepJournal::open() {
+	load();
+
+	fd = ::open(fileName.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+
+	if(fd < 0) {
+		errs() << "Warning: Could not open journal " << fileName << ": " << strerror(errno) << "\n";
+		return false;
+	}
+
+	if(!finished.empty())
+		outs() << "Resume sweep: " << finished.size() << " contexts were already analyzed.\n";
+
+	return true;
+}
+
+void SweepJournal::load() {
+	std::ifstream in(fileName.c_str());
+	std::string tag, cxtName;
+	uint32_t len = 0;
+
+	// A record that was interrupted while being written ends the journal.
+	while(in >> tag >> cxtName >> len) {
+		std::string payload(len, '\0');
+
+		in.get();
+		if(len > 0 && !in.read(&payload[0], len))
+			break;
+
+		if(tag == "begin")
+			numAttempts[cxtName]++;
+		else if(tag == "done")
+			finished.insert(cxtName);
+		else if(tag == "failed")
+			errs() << "Warning: Previous analysis of " << cxtName << " failed: " << payload << "\n";
+	}
+}
+
+bool SweepJournal::isDone(const std::string &cxtName) const {
+	if(finished.find(cxtName) != finished.end())
+		return true;
+
+	auto iter = numAttempts.find(cxtName);
+
+	return iter != numAttempts.end() && iter->second >= maxAttempts;
+}
+
+void SweepJournal::beginContext(const std::string &cxtName) {
+	append("begin", cxtName, "");
+}
+
+void SweepJournal::finishContext(const std::string &cxtName, const std::string &report) {
+	append("done", cxtName, report);
+}
+
+void SweepJournal::failContext(const std::string &cxtName, const std::string &reason) {
+	append("failed", cxtName, reason);
+}
+
+void SweepJournal::append(const std::string &tag, const std::string &cxtName, const std::string &payload) {
+	if(fd < 0)
+		return;
+
+	// One write per record, so the records of the workers of a sweep don't interleave.
+	std::string record = tag + " " + cxtName + " " + std::to_string(payload.size()) + "\n" + payload + "\n";
+	const char *data = record.data();
+	size_t len = record.size();
+
+	while(len > 0) {
+		ssize_t written = write(fd, data, len);
+
+		if(written < 0) {
+			if(errno == EINTR)
+				continue;
+			errs() << "Warning: Could not write journal " << fileName << "!\n";
+			return;
+		}
+
+		data += written;
+		len -= written;
+	}
+
+	fsync(fd);
+}
@@ -0,0 +1,82 @@
+#include "Util/ValueIDMap.h"
+
+ValueIDMap* ValueIDMap::valueIDMap = nullptr;
+
+void ValueIDMap::addModule(const llvm::Module &module) {
+	if(!frozen)
+		ids.reserve(ids.size() + module.size() + module.getGlobalList().size());
+
+	for(const auto &iter : module) {
+		if(iter.hasName())
+			symbols[&iter] = getID(iter.getName().str());
+	}
+
+	for(const auto &iter : module.globals()) {
+		if(iter.hasName())
+			symbols[&iter] = getID(iter.getName().str());
+	}
+}
+
+bool ValueIDMap::lookupID(const std::string &name, uint32_t &id) const {
+	if(frozen) {
+		auto iter = ids.find(name);
+
+		if(iter != ids.end()) {
+			id = iter->second;
+			return true;
+		}
+	}
+
+	llvm::sys::SmartScopedReader<true> reader(lock);
+	const auto &idMap = frozen ? lateIDs : ids;
+	auto iter = idMap.find(name);
+
+	if(iter == idMap.end())
+		return false;
+
+	id = iter->second;
+	return true;
+}
+
+uint32_t ValueIDMap::getID(const std::string &name) {
+	uint32_t id;
+
+	if(lookupID(name, id))
+		return id;
+
+	llvm::sys::SmartScopedWriter<true> writer(lock);
+	auto &idMap = frozen ? lateIDs : ids;
+	auto iter = idMap.find(name);
+
+	// Another thread might have numbered it in the meantime.
+	if(iter != idMap.end())
+		return iter->second;
+
+	id = names.size() + lateNames.size();
+	idMap[name] = id;
+
+	if(frozen)
+		lateNames.push_back(name);
+	else
+		names.push_back(name);
+
+	return id;
+}
+
+IDSet ValueIDMap::getIDs(const StringSet &set) {
+	IDSet idSet;
+
+	for(const auto &iter : set)
+		idSet.set(getID(iter));
+
+	return idSet;
+}
+
+StringSet ValueIDMap::getNames(const IDSet &set) const {
+	StringSet nameSet;
+
+	for(const auto &iter : set)
+		nameSet.insert(getName(iter));
+
+	return nameSet;
+}
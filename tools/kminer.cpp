@@ -9,12 +9,22 @@
 #include "KernelModels/KernelContext.h"
 #include "KernelModels/Driver.h"
 #include "KernelModels/KernelPartitioner.h"
+#include "KernelModels/ValueFlowPass.h"
 #include "Util/SyscallAPI.h"
 #include "Util/KMinerStat.h"
 #include "Util/DebugUtil.h"
 #include "Util/AnalysisUtil.h"
 #include "Util/BasicTypes.h"
 #include "Util/ReportPass.h"
+#include "Util/ContextWorkerPool.h"
+#include "Util/AnalysisState.h"
+#include "Util/PointsToCache.h"
+#include "Util/IncrementalAnalysis.h"
+#include "Util/AnalysisServer.h"
+#include "Util/SweepJournal.h"
+#include "Util/CostModel.h"
+#include "SVF/WPA/Andersen.h"
+#include "SVF/WPA/FlowSensitive.h"
 
 #include <llvm/Support/CommandLine.h>	
 #include <llvm/Bitcode/BitcodeWriterPass.h>
@@ -28,6 +38,10 @@
 #include <llvm/Bitcode/ReaderWriter.h>
 #include <llvm/Transforms/Utils/Cloning.h>
 #include <omp.h>
+#include <sstream>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cstring>
 
 using namespace llvm;
 using namespace analysisUtil;
@@ -56,12 +70,45 @@ static cl::opt<bool> FILECHECKER("fileck", cl::init(false),
 static cl::opt<bool> DFREECHECKER("double-free", cl::init(false),
 		cl::desc("Double Free Detection"));
 
+static cl::opt<bool> FUSECHECKERS("fuse-checkers", cl::init(false),
+		cl::desc("Memory-Leak, Use-After-Free and Double-Free share one traversal per allocation"));
+
 static cl::opt<bool> DUMPSYSCALLSTAT("dump-syscallstat", cl::init(false),
 		cl::desc("Prints the systemcall analysis statistics"));
 
 static cl::opt<unsigned int> NUMTHREADS("num-threads", cl::init(1),
 		cl::desc("The number of threads the UseAfterReturnAnalysis will run on."));
 
+static cl::opt<bool> LAZYLOAD("lazy-load", cl::init(false),
+		cl::desc("Only load the function bodies that are needed by the analyzed contexts."));
+
+static cl::opt<std::string> PTACACHE("pta-cache", cl::init(""),
+		cl::desc("Directory where the andersen results of the analyzed modules are cached."));
+
+static cl::opt<std::string> INCREMENTAL("incremental", cl::init(""),
+		cl::desc("Directory with the artifacts of previous runs, only changed contexts are analyzed again."));
+
+static cl::opt<std::string> SERVE("serve", cl::init(""),
+		cl::desc("Keep the kernel resident and serve analysis requests on this Unix domain socket."));
+
+static cl::opt<std::string> JOURNAL("journal", cl::init(""),
+		cl::desc("Records the progress of a sweep in this file, a restarted sweep resumes at the next context."));
+
+static cl::opt<bool> CRASHGUARD("crash-guard", cl::init(false),
+		cl::desc("Analyze every context in its own process, so a crash only loses this context."));
+
+static cl::opt<unsigned int> NUMWORKERS("num-workers", cl::init(1),
+		cl::desc("The number of processes that analyze the contexts of a sweep in parallel."));
+
+static cl::opt<std::string> COSTMODEL("cost-model", cl::init(""),
+		cl::desc("History of the analyzed contexts, it predicts the duration of the next ones."));
+
+static cl::opt<unsigned int> DEADLINE("deadline", cl::init(0),
+		cl::desc("Wall-clock time (sec) of a sweep, the time budgets of the contexts are fitted to it."));
+
+static cl::opt<unsigned int> MEMBUDGET("mem-budget", cl::init(0),
+		cl::desc("Memory (MB) the workers of a sweep may use together, the largest contexts run first."));
+
 /**
  * Kernel allocation functions shouldn't be analyzed. They will be removed
  * and replaced with a declaration. The analysis will handle the kernel
@@ -107,6 +154,16 @@ void preprocessing(llvm::Module &module) {
 	omp_set_num_threads(NUMTHREADS);
 	setupModule(module);
 
+	// The initcall groups of a level are independent, they share the workers of a sweep.
+	InitcallFactory::setWorkers(NUMWORKERS, (uint64_t)MEMBUDGET * 1024);
+
+	if(MEMBUDGET > 0 && NUMWORKERS <= 1)
+		errs() << "Warning: -mem-budget is ignored without -num-workers > 1!\n";
+
+	// Modules that were analyzed by a previous run don't have to be solved again.
+	if(PTACACHE != "")
+		Andersen::setResultCache(new PointsToCache(PTACACHE));
+
 	KMinerStat *kminerStat = KMinerStat::createKMinerStat();
 	kminerStat->setModuleName(module.getName());
 	kminerStat->setNumThreads(NUMTHREADS);
@@ -120,38 +177,355 @@ void postprocessing(llvm::Module &module) {
 	outs() << "====================================================\n";
 
 	KMinerStat::releaseKMinerStat();
+
+	delete Andersen::getResultCache();
+	Andersen::setResultCache(nullptr);
 }
 
 /**
- * Analyzes all the given system calls with the desired bug-detectors.
+ * The pointer analyses are singletons that refer to the module of the
+ * last context. They have to be rebuilt for the next context.
  */
-void startAnalysis(llvm::Module &module) {
-	preprocessing(module);
-	KernelContextFactory *kernelCxtFactory = new KernelContextFactory(module);
+void releaseContextAnalyses() {
+	AndersenWaveDiff::releaseAndersenWaveDiff();
+	FlowSensitive::releaseFSWPA();
+	PAG::releasePAG();
+}
+
+/**
+ * Describes the enabled bug-detectors, reports of other configurations can't be reused.
+ */
+std::string getCheckerConfig() {
+	std::string config;
+
+	config += USEAFTERRETURNCHECKER ? "R" : "-";
+	config += USEAFTERRETURNCHECKERLITE ? "r" : "-";
+	config += LEAKCHECKER ? "L" : "-";
+	config += USEAFTERFREECHECKER ? "U" : "-";
+	config += DFREECHECKER ? "F" : "-";
+	config += DLOCKCHECKER ? "D" : "-";
+
+	return config;
+}
 
-	while(kernelCxtFactory->updateContext()) {
+/**
+ * Runs the partitioner and the bug-detectors on the current context.
+ * If keepModule is set, the partitioner works on an extracted copy of the context and the
+ * parsed kernel stays untouched.
+ * The artifacts of the context are stored for later runs, if incremental is given.
+ * The cost model provides the time budget of the context and records its duration.
+ */
+void analyzeContext(llvm::Module &module, bool keepModule, IncrementalAnalysis *incremental, SweepJournal *journal,
+		CostModel *costModel) {
+	std::unique_ptr<llvm::Module> cxtModule;
+	llvm::Module *workModule = &module;
+	std::string cxtName = KernelContext::getKernelContext()->getAPI()->getName();
+	double start_t = omp_get_wtime();
+	KernelPartitioner *partitioner = new KernelPartitioner(incremental);
+
+	// Only the values of the merged contexts are copied, not the whole kernel.
+	if(keepModule) {
+		StringSet relevantFuncs;
+		StringSet relevantGVs;
+
+		partitioner->getRelevantValues(relevantFuncs, relevantGVs);
+		cxtModule = analysisUtil::extractModule(module, relevantFuncs, relevantGVs);
+		workModule = cxtModule.get();
+	}
+
+	if(costModel)
+		KernelContext::getKernelContext()->setTimeBudget(costModel->getTimeBudget(cxtName));
+
+	{
 		llvm::legacy::PassManager Passes;
 
-		Passes.add(new KernelPartitioner());
+		Passes.add(partitioner);
+
+		// PAG, andersen and SVFG are built once and shared by the checkers.
+		if(USEAFTERRETURNCHECKER || USEAFTERRETURNCHECKERLITE || LEAKCHECKER || 
+				USEAFTERFREECHECKER || DFREECHECKER || DLOCKCHECKER)
+			Passes.add(new ValueFlowPass());
 
 		if(USEAFTERRETURNCHECKER)
 			Passes.add(new UseAfterReturnChecker(NUMTHREADS));
 		if(USEAFTERRETURNCHECKERLITE)
 			Passes.add(new UseAfterReturnCheckerLite(NUMTHREADS));
-		if(LEAKCHECKER)
-			Passes.add(new MemLeakChecker());
-		if(USEAFTERFREECHECKER)
-			Passes.add(new UseAfterFreeChecker());
-		if(DFREECHECKER)
-			Passes.add(new DoubleFreeChecker());
+
+		// These checkers share their sources and most of their sinks.
+		std::vector<SrcSnkAnalysis*> memCheckers;
+
+		if(LEAKCHECKER) {
+			MemLeakChecker *checker = new MemLeakChecker();
+			memCheckers.push_back(checker);
+			Passes.add(checker);
+		}
+		if(USEAFTERFREECHECKER) {
+			UseAfterFreeChecker *checker = new UseAfterFreeChecker();
+			memCheckers.push_back(checker);
+			Passes.add(checker);
+		}
+		if(DFREECHECKER) {
+			DoubleFreeChecker *checker = new DoubleFreeChecker();
+			memCheckers.push_back(checker);
+			Passes.add(checker);
+		}
+
+		if(FUSECHECKERS && memCheckers.size() > 1)
+			SrcSnkAnalysis::fuse(memCheckers);
+
 		if(DLOCKCHECKER)
 			Passes.add(new DoubleLockChecker());
 
 		Passes.add(new ReportPass());
 
-		Passes.run(module);
+		Passes.run(*workModule);
 	}
 
+	// The partitioner recorded the functions and variables the reports depend on.
+	if(incremental)
+		incremental->storeContext(cxtName, ReportPass::getLastReport());
+	if(journal)
+		journal->finishContext(cxtName, ReportPass::getLastReport());
+	if(costModel)
+		costModel->record(cxtName, ReportPass::getLastFeatures(), omp_get_wtime()-start_t);
+
+	releaseContextAnalyses();
+	cxtModule.reset();
+}
+
+/**
+ * Analyzes the context in a forked process, so a crash of the analysis (e.g. an
+ * assertion in SVF or the OOM killer) only loses this context. The forked
+ * process runs single-threaded.
+ */
+void analyzeGuardedContext(llvm::Module &module, KernelContextFactory *kernelCxtFactory, const std::string &cxtRoot,
+		IncrementalAnalysis *incremental, SweepJournal *journal, CostModel *costModel) {
+	pid_t pid = analysisUtil::forkAnalysisProcess();
+
+	if(pid == 0) {
+		// The forked process owns its copy of the kernel and doesn't have to keep it.
+		kernelCxtFactory->setContextRoots(StringList(1, cxtRoot));
+		if(kernelCxtFactory->updateContext())
+			analyzeContext(module, false, incremental, journal, costModel);
+
+		outs().flush();
+		errs().flush();
+		_exit(0);
+	}
+
+	if(pid < 0) {
+		errs() << "Warning: Could not fork the analysis of " << cxtRoot << ", it runs unguarded!\n";
+		kernelCxtFactory->setContextRoots(StringList(1, cxtRoot));
+		if(kernelCxtFactory->updateContext())
+			analyzeContext(module, true, incremental, journal, costModel);
+		return;
+	}
+
+	int status = 0;
+	waitpid(pid, &status, 0);
+
+	if(WIFEXITED(status) && WEXITSTATUS(status) == 0)
+		return;
+
+	std::string reason = WIFSIGNALED(status) ? std::string("killed by ") + strsignal(WTERMSIG(status)) :
+		"exit status " + std::to_string(WEXITSTATUS(status));
+
+	errs() << "Warning: Analysis of " << cxtRoot << " failed (" << reason << ")!\n";
+
+	if(journal)
+		journal->failContext(cxtRoot, reason);
+}
+
+/**
+ * Analyzes all the given system calls with the desired bug-detectors.
+ */
+void startAnalysis(llvm::Module &module) {
+	// The singletons of the analysis belong to this state and are released with it.
+	AnalysisState state;
+	AnalysisState::Scope stateScope(state);
+
+	preprocessing(module);
+	KernelContextFactory *kernelCxtFactory = new KernelContextFactory(module);
+	std::unique_ptr<IncrementalAnalysis> incremental;
+
+	if(INCREMENTAL != "") {
+		// Contexts that didn't change since the previous run only get their old report.
+		incremental.reset(new IncrementalAnalysis(module, INCREMENTAL, getCheckerConfig()));
+		StringList changedRoots;
+
+		for(const auto &iter : kernelCxtFactory->getContextRoots()) {
+			if(!incremental->carryForward(iter))
+				changedRoots.push_back(iter);
+		}
+
+		outs() << "Contexts to analyze: " << changedRoots.size() << " (" 
+		       << incremental->getNumCarriedForward() << " unchanged)\n";
+		kernelCxtFactory->setContextRoots(changedRoots);
+	}
+
+	std::unique_ptr<SweepJournal> journal;
+
+	if(JOURNAL != "") {
+		// Contexts that were finished by an interrupted sweep are skipped.
+		journal.reset(new SweepJournal(JOURNAL));
+		StringList openRoots;
+
+		if(journal->open()) {
+			for(const auto &iter : kernelCxtFactory->getContextRoots()) {
+				if(!journal->isDone(iter))
+					openRoots.push_back(iter);
+			}
+
+			kernelCxtFactory->setContextRoots(openRoots);
+		} else {
+			journal.reset();
+		}
+	}
+
+	std::unique_ptr<CostModel> costModel;
+
+	if(COSTMODEL != "") {
+		// The durations of previous runs order the contexts and fit them into the deadline.
+		costModel.reset(new CostModel(COSTMODEL));
+
+		if(costModel->load()) {
+			StringList cxtRoots = kernelCxtFactory->getContextRoots();
+			costModel->orderContexts(cxtRoots);
+			kernelCxtFactory->setContextRoots(cxtRoots);
+
+			if(DEADLINE > 0)
+				costModel->planBudgets(cxtRoots, DEADLINE, NUMWORKERS);
+		}
+	}
+
+	if(NUMWORKERS > 1 && kernelCxtFactory->getContextRoots().size() > 1) {
+		// Every context is analyzed by its own worker, in place on the copy-on-write kernel.
+		// The workers guard the sweep against crashes like -crash-guard does.
+		ContextWorkerPool workerPool(NUMWORKERS, (uint64_t)MEMBUDGET * 1024);
+
+		// The scheduler predicts the memory of a context by its size.
+		if(MEMBUDGET > 0) {
+			for(const auto &iter : kernelCxtFactory->estimateContextSizes(kernelCxtFactory->getContextRoots()))
+				workerPool.setContextSize(iter.first, iter.second);
+		}
+
+		workerPool.run(kernelCxtFactory->getContextRoots(), [&](const std::string &cxtRoot) {
+			if(journal)
+				journal->beginContext(cxtRoot);
+
+			kernelCxtFactory->setContextRoots(StringList(1, cxtRoot));
+			if(!kernelCxtFactory->updateContext())
+				return;
+
+			// Only if no worker could be forked, the context is analyzed by the parent itself.
+			analyzeContext(module, !ContextWorkerPool::isWorker(), incremental.get(), journal.get(), 
+					costModel.get());
+		}, ReportPass::writeToReport, [&](const std::string &cxtRoot, const std::string &reason) {
+			// Like with -crash-guard, the failure is recorded and the sweep goes on.
+			if(journal)
+				journal->failContext(cxtRoot, reason);
+		});
+	} else if(CRASHGUARD) {
+		StringList cxtRoots = kernelCxtFactory->getContextRoots();
+
+		for(const auto &iter : cxtRoots) {
+			if(journal)
+				journal->beginContext(iter);
+
+			analyzeGuardedContext(module, kernelCxtFactory, iter, incremental.get(), journal.get(), costModel.get());
+		}
+	} else {
+		while(kernelCxtFactory->hasNextContext()) {
+			if(journal)
+				journal->beginContext(kernelCxtFactory->getContextRoots().front());
+
+			if(!kernelCxtFactory->updateContext())
+				break;
+
+			analyzeContext(module, kernelCxtFactory->hasNextContext(), incremental.get(), journal.get(),
+					costModel.get());
+		}
+	}
+
+	delete kernelCxtFactory;
+	postprocessing(module);
+}
+
+/**
+ * Enables the bug-detectors of a comma separated list, returns false if one is unknown.
+ */
+bool selectCheckers(const std::string &checkers) {
+	std::stringstream stream(checkers);
+	std::string checker;
+
+	LEAKCHECKER = USEAFTERFREECHECKER = USEAFTERRETURNCHECKER = false;
+	USEAFTERRETURNCHECKERLITE = DLOCKCHECKER = DFREECHECKER = false;
+
+	while(std::getline(stream, checker, ',')) {
+		if(checker == "leak")
+			LEAKCHECKER = true;
+		else if(checker == "use-after-free" || checker == "uaf")
+			USEAFTERFREECHECKER = true;
+		else if(checker == "use-after-return" || checker == "uar")
+			USEAFTERRETURNCHECKER = true;
+		else if(checker == "use-after-return-lite" || checker == "uar-lite")
+			USEAFTERRETURNCHECKERLITE = true;
+		else if(checker == "double-lock")
+			DLOCKCHECKER = true;
+		else if(checker == "double-free")
+			DFREECHECKER = true;
+		else
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * Analyzes a request of the form "analyze <syscall>|driver:<file> [with <checker>,...]".
+ * Runs in the forked handler process, so the resident kernel can be modified freely.
+ */
+void handleRequest(llvm::Module &module, KernelContextFactory *kernelCxtFactory, const std::string &request) {
+	std::stringstream stream(request);
+	std::string command, cxtRoot, with, checkers;
+	KernelContextObj::CONTEXT_TYPE type = KernelContextObj::SYSCALL;
+
+	stream >> command >> cxtRoot >> with >> checkers;
+
+	if(command != "analyze" || cxtRoot == "" || (with != "" && (with != "with" || !selectCheckers(checkers)))) {
+		AnalysisServer::sendResult("error: usage: analyze <syscall>|driver:<file> [with <checker>,...]\n");
+		return;
+	}
+
+	if(cxtRoot.compare(0, 7, "driver:") == 0) {
+		cxtRoot = cxtRoot.substr(7);
+		type = KernelContextObj::DRIVER;
+	} else if(module.getFunction(cxtRoot) == nullptr) {
+		AnalysisServer::sendResult("error: system call " + cxtRoot + " not found\n");
+		return;
+	}
+
+	kernelCxtFactory->selectAPI(cxtRoot, type);
+
+	if(kernelCxtFactory->updateContext())
+		analyzeContext(module, false, nullptr, nullptr, nullptr);
+}
+
+/**
+ * Builds the kernel-wide analyses once and serves requests until terminated.
+ */
+void startServer(llvm::Module &module) {
+	AnalysisState state;
+	AnalysisState::Scope stateScope(state);
+
+	preprocessing(module);
+	KernelContextFactory *kernelCxtFactory = new KernelContextFactory(module, true);
+	AnalysisServer server(SERVE, NUMWORKERS);
+
+	server.run([&](const std::string &request) {
+		handleRequest(module, kernelCxtFactory, request);
+	});
+
 	delete kernelCxtFactory;
 	postprocessing(module);
 }
@@ -182,14 +556,23 @@ int main(int argc, char ** argv) {
 	SMDiagnostic Err;
 
 	// Load the input module...
-	std::unique_ptr<Module> M1 = parseIRFile(InputFilename, Err, Context);
+	std::unique_ptr<Module> M1;
+
+	// The function bodies are loaded on demand by the context builders.
+	if(LAZYLOAD)
+		M1 = getLazyIRFileModule(InputFilename, Err, Context);
+	else
+		M1 = parseIRFile(InputFilename, Err, Context);
 
 	if (!M1) {
 		Err.print(argv[0], errs());
 		return 1;
 	}
 
-	startAnalysis(*M1.get());
+	if(SERVE != "")
+		startServer(*M1.get());
+	else
+		startAnalysis(*M1.get());
 
 	return 0;
 }